@@ -0,0 +1,258 @@
+#ifndef ASYNC_QUEUE_H
+#define ASYNC_QUEUE_H
+
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "Queue.h"
+#include "SingleThreadedExecutor.h"
+
+
+/*
+ * AsyncQueue - Queue whose consumers are coroutines: co_await pop() suspends until an element arrives,
+ * co_await popBatch(max) suspends until at least one element arrives and returns up to max of them.
+ * Suspended consumers are resumed on the executor given at construction. A producer running on the
+ * executor's thread hands elements over without any system call.
+ * Producers may push from any thread.
+*/
+template <class T>
+class AsyncQueue {
+
+    struct Waiter;
+
+public:
+
+    class PopAwaiter;
+    class PopBatchAwaiter;
+
+    /*
+     * C'tor for AsyncQueue class.
+     *
+     * @param executor - the executor that resumes suspended consumers.
+     * @return
+     * A new instance of AsyncQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit AsyncQueue(SingleThreadedExecutor& executor);
+
+    /*
+     * Suspended consumers hold the address of the queue, so copying is not allowed.
+    */
+    AsyncQueue(const AsyncQueue& queue) = delete;
+    AsyncQueue& operator=(const AsyncQueue& otherQueue) = delete;
+    ~AsyncQueue() = default;
+
+    /*
+     * push - Hands the element to the first suspended consumer, or inserts it at the end of the queue.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown.
+    */
+    void push(const T& argumentToAdd);
+
+    /*
+     * pop - Awaitable that removes and returns the first element of the queue,
+     * suspending the awaiting coroutine while the queue is empty.
+    */
+    PopAwaiter pop();
+
+    /*
+     * popBatch - Awaitable that removes and returns up to maxItems elements of the queue as a Queue<T>,
+     * suspending the awaiting coroutine while the queue is empty.
+     *
+     * @param maxItems - the maximal number of elements to return, at least 1.
+    */
+    PopBatchAwaiter popBatch(int maxItems);
+
+    /*
+     * size - the number of elements waiting in the queue.
+    */
+    int size() const;
+
+private:
+
+    /*
+     * Waiter - a suspended consumer. A single pop has no batch and receives its element in m_value.
+    */
+    struct Waiter {
+        std::coroutine_handle<> m_handle;
+        std::optional<T> m_value;
+        Queue<T>* m_batch = nullptr;
+        int m_maxItems = 1;
+    };
+
+    SingleThreadedExecutor& m_executor;
+    mutable std::mutex m_mutex;
+    Queue<T> m_data;
+    Queue<Waiter*> m_waiters;
+
+    /*
+     * takeItems - moves up to maxItems - batch size elements from the queue into the batch.
+     * Must be called with m_mutex held.
+    */
+    void takeItems(Queue<T>& batch, int maxItems);
+};
+
+
+/* -------------------------------------------- Awaiter Classes -------------------------------------------- */
+
+template <class T>
+class AsyncQueue<T>::PopAwaiter {
+
+public:
+
+    /*
+     * The waiter is registered by address, so copying is not allowed.
+    */
+    PopAwaiter(const PopAwaiter& awaiter) = delete;
+    PopAwaiter& operator=(const PopAwaiter& otherPopAwaiter) = delete;
+    ~PopAwaiter() = default;
+
+    bool await_ready() const noexcept { return false; }
+
+    /*
+     * Takes the first element right away if there is one, else registers as a waiter and suspends.
+    */
+    bool await_suspend(std::coroutine_handle<> handle){
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        m_waiter.m_value = m_queue->m_data.tryPopFront();
+        if(m_waiter.m_value){
+            return false;
+        }
+        m_waiter.m_handle = handle;
+        m_queue->m_waiters.pushBack(&m_waiter);
+        return true;
+    }
+
+    T await_resume(){
+        return std::move(*m_waiter.m_value);
+    }
+
+private:
+
+    AsyncQueue<T>* m_queue;
+    Waiter m_waiter;
+
+    explicit PopAwaiter(AsyncQueue<T>* queue) : m_queue(queue) {}
+    friend class AsyncQueue;
+};
+
+template <class T>
+class AsyncQueue<T>::PopBatchAwaiter {
+
+public:
+
+    /*
+     * The waiter is registered by address, so copying is not allowed.
+    */
+    PopBatchAwaiter(const PopBatchAwaiter& awaiter) = delete;
+    PopBatchAwaiter& operator=(const PopBatchAwaiter& otherPopBatchAwaiter) = delete;
+    ~PopBatchAwaiter() = default;
+
+    bool await_ready() const noexcept { return false; }
+
+    /*
+     * Takes the waiting elements right away if there are any, else registers as a waiter and suspends.
+    */
+    bool await_suspend(std::coroutine_handle<> handle){
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        if(m_queue->m_data.size() > 0){
+            m_queue->takeItems(m_batch, m_waiter.m_maxItems);
+            return false;
+        }
+        m_waiter.m_handle = handle;
+        m_queue->m_waiters.pushBack(&m_waiter);
+        return true;
+    }
+
+    /*
+     * Elements pushed between the wake up and the resumption join the batch, so a single wake up
+     * may carry up to maxItems elements.
+    */
+    Queue<T> await_resume(){
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        m_queue->takeItems(m_batch, m_waiter.m_maxItems);
+        /* Swapped out, as returning the member would copy every element */
+        Queue<T> batch;
+        batch.swap(m_batch);
+        return batch;
+    }
+
+private:
+
+    AsyncQueue<T>* m_queue;
+    Waiter m_waiter;
+    Queue<T> m_batch;
+
+    PopBatchAwaiter(AsyncQueue<T>* queue, int maxItems) : m_queue(queue) {
+        m_waiter.m_batch = &m_batch;
+        m_waiter.m_maxItems = maxItems > 0 ? maxItems : 1;
+    }
+    friend class AsyncQueue;
+};
+
+/* ---------------------------------------- End of Awaiter Classes ---------------------------------------- */
+
+/* ------------------------------------ Public Functions of AsyncQueue Class ------------------------------------*/
+
+template <class T>
+AsyncQueue<T>::AsyncQueue(SingleThreadedExecutor& executor) : m_executor(executor) {}
+
+template <class T>
+void AsyncQueue<T>::push(const T& argumentToAdd){
+    Waiter* waiter = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_waiters.size() == 0){
+            m_data.pushBack(argumentToAdd);
+            return;
+        }
+        waiter = m_waiters.front();
+        if(waiter->m_batch == nullptr){
+            waiter->m_value = argumentToAdd;
+        }
+        else{
+            waiter->m_batch->pushBack(argumentToAdd);
+        }
+        m_waiters.popFront();
+    }
+    m_executor.schedule(waiter->m_handle);
+}
+
+template <class T>
+typename AsyncQueue<T>::PopAwaiter AsyncQueue<T>::pop(){
+    return PopAwaiter(this);
+}
+
+template <class T>
+typename AsyncQueue<T>::PopBatchAwaiter AsyncQueue<T>::popBatch(int maxItems){
+    return PopBatchAwaiter(this, maxItems);
+}
+
+template <class T>
+int AsyncQueue<T>::size() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_data.size();
+}
+
+/* --------------------------------- End of Public Functions of AsyncQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of AsyncQueue Class ------------------------------------*/
+
+template <class T>
+void AsyncQueue<T>::takeItems(Queue<T>& batch, int maxItems){
+    while(batch.size() < maxItems && m_data.size() > 0){
+        batch.pushBack(m_data.popAndGet());
+    }
+}
+
+/* -------------------------------- End of Private Functions of AsyncQueue Class --------------------------------*/
+
+#endif //ASYNC_QUEUE_H
@@ -0,0 +1,105 @@
+#include <thread>
+
+#include "AsyncQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+static AsyncTask consumeSum(AsyncQueue<int>& queue, int count, int& sum)
+{
+	for (int i = 0; i < count; i++) {
+		sum += co_await queue.pop();
+	}
+}
+
+static AsyncTask consumeBatches(AsyncQueue<int>& queue, int count, Queue<int>& batchSizes)
+{
+	int received = 0;
+	while (received < count) {
+		Queue<int> batch = co_await queue.popBatch(4);
+		batchSizes.pushBack(batch.size());
+		received += batch.size();
+	}
+}
+
+static AsyncTask stopWhenDone(AsyncQueue<int>& queue, SingleThreadedExecutor& executor, int count, int& sum)
+{
+	for (int i = 0; i < count; i++) {
+		sum += co_await queue.pop();
+	}
+	executor.stop();
+}
+
+namespace AsyncQueueTests {
+
+bool testPop()
+{
+	bool testResult = true;
+
+	SingleThreadedExecutor executor;
+	AsyncQueue<int> queue(executor);
+	int sum = 0;
+	queue.push(1);
+	executor.spawn(consumeSum(queue, 3, sum));
+	executor.runUntilIdle();
+	AGREGATE_TEST_RESULT(testResult, sum == 1);
+
+	queue.push(2);
+	queue.push(3);
+	AGREGATE_TEST_RESULT(testResult, sum == 1);
+	executor.runUntilIdle();
+	AGREGATE_TEST_RESULT(testResult, sum == 6);
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 0);
+
+	return testResult;
+}
+
+bool testPopBatch()
+{
+	bool testResult = true;
+
+	SingleThreadedExecutor executor;
+	AsyncQueue<int> queue(executor);
+	Queue<int> batchSizes;
+	executor.spawn(consumeBatches(queue, 7, batchSizes));
+	executor.runUntilIdle();
+	AGREGATE_TEST_RESULT(testResult, batchSizes.size() == 0);
+
+	/* the first push wakes the consumer, the next ones join its batch before it runs */
+	for (int i = 0; i < 6; i++) {
+		queue.push(i);
+	}
+	executor.runUntilIdle();
+	queue.push(6);
+	executor.runUntilIdle();
+
+	AGREGATE_TEST_RESULT(testResult, batchSizes.size() == 3);
+	AGREGATE_TEST_RESULT(testResult, batchSizes.front() == 4);
+	batchSizes.popFront();
+	AGREGATE_TEST_RESULT(testResult, batchSizes.front() == 2);
+	batchSizes.popFront();
+	AGREGATE_TEST_RESULT(testResult, batchSizes.front() == 1);
+
+	return testResult;
+}
+
+bool testRemoteProducer()
+{
+	bool testResult = true;
+
+	SingleThreadedExecutor executor;
+	AsyncQueue<int> queue(executor);
+	int sum = 0;
+	executor.spawn(stopWhenDone(queue, executor, 100, sum));
+	std::thread producer([&queue]() {
+		for (int i = 1; i <= 100; i++) {
+			queue.push(i);
+		}
+	});
+	executor.run();
+	producer.join();
+	AGREGATE_TEST_RESULT(testResult, sum == 5050);
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,101 @@
+#include "AtomicHealthPoints.h"
+
+namespace {
+
+unsigned long long packState(int maxHP, int currentHP){
+    return (static_cast<unsigned long long>(static_cast<unsigned>(maxHP)) << 32) | static_cast<unsigned>(currentHP);
+}
+
+int maxOf(unsigned long long state){
+    return static_cast<int>(state >> 32);
+}
+
+int currentOf(unsigned long long state){
+    return static_cast<int>(state & 0xFFFFFFFFull);
+}
+
+}
+
+
+AtomicHealthPoints::AtomicHealthPoints(int maxHP) : m_state(0) {
+
+    if(maxHP > 0){
+        m_state.store(packState(maxHP, maxHP), std::memory_order_relaxed);
+    }
+    else{
+        throw InvalidArgument();
+    }
+
+}
+
+
+int AtomicHealthPoints::addClamped(long long hpToAdd){
+    unsigned long long state = m_state.load(std::memory_order_relaxed);
+    while(true){
+        int maxHP = maxOf(state);
+        long long currentHP = currentOf(state) + hpToAdd;
+        if(currentHP > maxHP){
+            currentHP = maxHP;
+        }
+        if(currentHP < 0){
+            currentHP = 0;
+        }
+        /* On failure state is reloaded with the value another thread stored, and the clamp is redone */
+        if(m_state.compare_exchange_weak(state, packState(maxHP, static_cast<int>(currentHP)),
+                                         std::memory_order_acq_rel, std::memory_order_relaxed)){
+            return currentOf(state);
+        }
+    }
+}
+
+AtomicHealthPoints& AtomicHealthPoints::operator+=(int hpToAdd){
+    addClamped(hpToAdd);
+    return *this;
+}
+
+AtomicHealthPoints& AtomicHealthPoints::operator-=(int hpToDecrease){
+    addClamped(-static_cast<long long>(hpToDecrease));
+    return *this;
+}
+
+int AtomicHealthPoints::fetchDamage(int hpToDecrease){
+    return addClamped(-static_cast<long long>(hpToDecrease));
+}
+
+int AtomicHealthPoints::getCurrentHP() const{
+    return currentOf(m_state.load(std::memory_order_relaxed));
+}
+
+int AtomicHealthPoints::getMaxHP() const{
+    return maxOf(m_state.load(std::memory_order_relaxed));
+}
+
+HealthPoints AtomicHealthPoints::snapshot() const{
+    unsigned long long state = m_state.load(std::memory_order_acquire);
+    return HealthPoints(maxOf(state), currentOf(state));
+}
+
+bool operator==(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return(healthPoints1.getCurrentHP() == healthPoints2.getCurrentHP());
+}
+bool operator!=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return !(healthPoints1 == healthPoints2);
+}
+bool operator<(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return(healthPoints1.getCurrentHP() < healthPoints2.getCurrentHP());
+}
+bool operator<=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return !(healthPoints1 > healthPoints2);
+}
+bool operator>(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return (healthPoints2 < healthPoints1);
+}
+bool operator>=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2){
+    return (healthPoints2 <= healthPoints1);
+}
+
+
+std::ostream& operator<<(std::ostream& stream , const AtomicHealthPoints& healthPoints){
+    /* A single load, so the printed current and max hp belong to the same state */
+    return stream << healthPoints.snapshot();
+}
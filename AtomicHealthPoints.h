@@ -0,0 +1,171 @@
+#ifndef ATOMIC_HEALTH_POINTS_H
+#define ATOMIC_HEALTH_POINTS_H
+
+#include <atomic>
+#include <iostream>
+
+#include "HealthPoints.h"
+
+/*
+ * AtomicHealthPoints - HealthPoints that may be damaged and healed by several threads at once, without a lock.
+ * The current and max hp are packed into a single 64 bit word, which is updated by a compare and swap loop,
+ * so the clamping to [0, maxHP] is part of the same atomic step as the addition.
+*/
+class AtomicHealthPoints{
+
+public:
+
+    /*
+     * C'tor for AtomicHealthPoints class.
+     *
+     * @param maxHP - Max health points.
+     * @return
+     * A new instance of AtomicHealthPoints if maxHP is positive integer,
+     * else throws an exception: InvalidArgument.
+    */
+    AtomicHealthPoints(int maxHP = DEFAULT_MAX_HP);
+
+    /*
+     * operator+= - atomically adds hp, up to the max hp.
+     *
+     * @param hpToAdd - The amount of hp to add.
+     * @return
+     * The instance of AtomicHealthPoints the operator has been used on.
+    */
+    AtomicHealthPoints& operator+=(int hpToAdd);
+
+    /*
+     * operator-= - atomically decreases hp, down to 0.
+     *
+     * @param hpToDecrease - The amount of hp to decrease.
+     * @return
+     * The instance of AtomicHealthPoints the operator has been used on.
+    */
+    AtomicHealthPoints& operator-=(int hpToDecrease);
+
+    /*
+     * fetchDamage - atomically decreases hp, down to 0, and returns the hp it had before.
+     * Exactly one of several threads that bring the hp to 0 sees a positive value returned,
+     * which makes it the thread that handles the death of the entity.
+     *
+     * @param hpToDecrease - The amount of hp to decrease.
+     * @return
+     * Returns the current hp before the damage.
+    */
+    int fetchDamage(int hpToDecrease);
+
+    /*
+     * getCurrentHP - the current hp, read without ordering against other memory operations.
+    */
+    int getCurrentHP() const;
+
+    /*
+     * getMaxHP - the max hp.
+    */
+    int getMaxHP() const;
+
+    /*
+     * snapshot - copy of the current state as a plain HealthPoints.
+    */
+    HealthPoints snapshot() const;
+
+    /*
+     * The state is shared between threads by address, so copying is not allowed.
+    */
+    ~AtomicHealthPoints() = default;
+    AtomicHealthPoints(const AtomicHealthPoints& healthPoints) = delete;
+    AtomicHealthPoints& operator=(const AtomicHealthPoints& otherHealthPoints) = delete;
+
+    /*
+    * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+private:
+
+    /* Max hp in the high 32 bits, current hp in the low 32 bits */
+    std::atomic<unsigned long long> m_state;
+
+    /*The default max hp of an AtomicHealthPoints instance*/
+    static const int DEFAULT_MAX_HP = 100;
+
+    /*
+     * addClamped - atomically adds hpToAdd, which may be negative, clamping the result to [0, maxHP].
+     *
+     * @return
+     * Returns the current hp before the addition.
+    */
+    int addClamped(long long hpToAdd);
+};
+
+/*
+* operator==
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the objects has the same current hp, else false.
+*/
+bool operator==(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator!=
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the objects does not have the same current hp, else false.
+*/
+bool operator!=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator<
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the first object has lower current hp than the second object, else false.
+*/
+bool operator<(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator<=
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the first object has lower or equal current hp than the second object, else false.
+*/
+bool operator<=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator>
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the first object has more current hp than the second object, else false.
+*/
+bool operator>(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator>=
+*
+* @param healthPoints1 - The first object for comparison.
+* @param healthPoints2 - The second object for comparison.
+* @return
+* Returns true if the first object has more or equal current hp than the second object, else false.
+*/
+bool operator>=(const AtomicHealthPoints& healthPoints1, const AtomicHealthPoints& healthPoints2);
+
+/*
+* operator<< - prints the healthPoints object in the format <currentValue>(<maxValue>)
+*
+* @param stream - output stream.
+* @param healthPoints - instance of AtomicHealthPoints to print.
+* @return
+* Returns the output stream that has been used.
+*/
+std::ostream& operator<<(std::ostream& stream , const AtomicHealthPoints& healthPoints);
+
+#endif //ATOMIC_HEALTH_POINTS_H
@@ -0,0 +1,84 @@
+#include <sstream>
+#include <thread>
+
+#include "AtomicHealthPoints.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace AtomicHealthPointsTests {
+
+bool testClampedOperations()
+{
+	bool testResult = true;
+
+	AtomicHealthPoints healthPoints1(50);
+	AtomicHealthPoints healthPoints2;
+	healthPoints1 -= 20;
+	healthPoints1 += 5;
+	AGREGATE_TEST_RESULT(testResult, healthPoints1.getCurrentHP() == 35 && healthPoints1.getMaxHP() == 50);
+	healthPoints1 += 1000;
+	AGREGATE_TEST_RESULT(testResult, healthPoints1.getCurrentHP() == 50);
+	healthPoints2 -= 2147483647;
+	AGREGATE_TEST_RESULT(testResult, healthPoints2.getCurrentHP() == 0 && healthPoints2.getMaxHP() == 100);
+	healthPoints2 += -10;
+	AGREGATE_TEST_RESULT(testResult, healthPoints2.getCurrentHP() == 0);
+
+	AGREGATE_TEST_RESULT(testResult, healthPoints2 < healthPoints1 && healthPoints1 != healthPoints2);
+	AGREGATE_TEST_RESULT(testResult, healthPoints2 <= healthPoints1 && healthPoints1 > healthPoints2 && healthPoints1 >= healthPoints2);
+	AGREGATE_TEST_RESULT(testResult, !(healthPoints1 <= healthPoints2) && healthPoints1 >= healthPoints1);
+	AGREGATE_TEST_RESULT(testResult, healthPoints1.fetchDamage(30) == 50 && healthPoints1.fetchDamage(30) == 20);
+	AGREGATE_TEST_RESULT(testResult, healthPoints1.fetchDamage(30) == 0 && healthPoints1 == healthPoints2);
+
+	healthPoints1 += 7;
+	std::ostringstream stream;
+	stream << healthPoints1;
+	AGREGATE_TEST_RESULT(testResult, stream.str() == "7(50)");
+	HealthPoints snapshot = healthPoints1.snapshot();
+	AGREGATE_TEST_RESULT(testResult, snapshot == HealthPoints(50) - 43);
+
+	bool exceptionThrown = false;
+	try {
+		AtomicHealthPoints healthPoints3(0);
+	}
+	catch (AtomicHealthPoints::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testConcurrentDamage()
+{
+	bool testResult = true;
+
+	const int NUMBER_OF_THREADS = 4;
+	const int HITS_PER_THREAD = 20000;
+	AtomicHealthPoints healthPoints(NUMBER_OF_THREADS * 10);
+	AtomicHealthPoints boss(HITS_PER_THREAD);
+	int killingBlows[NUMBER_OF_THREADS] = { 0 };
+	std::thread threads[NUMBER_OF_THREADS];
+	for (int t = 0; t < NUMBER_OF_THREADS; t++) {
+		threads[t] = std::thread([&, t]() {
+			for (int i = 0; i < HITS_PER_THREAD; i++) {
+				/* every heal follows a damage of the same thread, so the hp never reaches the bounds */
+				healthPoints -= 5;
+				healthPoints += 5;
+				if (boss.fetchDamage(1) == 1) {
+					killingBlows[t]++;
+				}
+			}
+		});
+	}
+	int totalKillingBlows = 0;
+	for (int t = 0; t < NUMBER_OF_THREADS; t++) {
+		threads[t].join();
+		totalKillingBlows += killingBlows[t];
+	}
+	AGREGATE_TEST_RESULT(testResult, healthPoints.getCurrentHP() == NUMBER_OF_THREADS * 10);
+	AGREGATE_TEST_RESULT(testResult, boss.getCurrentHP() == 0 && totalKillingBlows == 1);
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,223 @@
+#ifndef BATCHING_CONSUMER_H
+#define BATCHING_CONSUMER_H
+
+#include <chrono>
+#include <span>
+
+#include "Queue.h"
+
+
+/*
+ * BatchingConsumer - Pops elements from a source queue into a contiguous batch, and hands the batch
+ * to a handler once it holds maxBatchSize elements or its oldest element waited maxLatency,
+ * whichever comes first. An optional token bucket limits the number of elements handed over per second.
+ *
+ * The source may be a Queue<T> or any of its concurrent variants - anything with bool popFrontInto(T&).
+ * The batch is handed over as a std::span<T> over the consumer's own buffer, so the handler may
+ * read or move the elements without another copy. The span is valid until the handler returns.
+*/
+template <class T, class Source = Queue<T>, class Clock = std::chrono::steady_clock>
+class BatchingConsumer {
+
+public:
+
+    typedef typename Clock::time_point TimePoint;
+    typedef typename Clock::duration Duration;
+
+    /*
+     * C'tor for BatchingConsumer class.
+     *
+     * @param source - the queue to consume, which must outlive the consumer.
+     * @param maxBatchSize - a batch is flushed once it holds this many elements.
+     * @param maxLatency - a batch is flushed once its oldest element waited this long.
+     * @param elementsPerSecond - rate limit of the token bucket, 0 for no rate limit.
+     * @param burstSize - capacity of the token bucket, at least maxBatchSize.
+     * @return
+     * A new instance of BatchingConsumer.
+     * @exception
+     * InvalidArgument exception if maxBatchSize is not positive,
+     * std::bad_alloc exception might be thrown.
+    */
+    BatchingConsumer(Source& source, int maxBatchSize, Duration maxLatency, double elementsPerSecond = 0,
+                     int burstSize = 0);
+
+    /*
+     * D'tor for BatchingConsumer class.
+     * Elements still pending in the batch are destroyed with it.
+    */
+    ~BatchingConsumer();
+
+    /*
+     * The consumer owns its batch buffer, so copying is not allowed.
+    */
+    BatchingConsumer(const BatchingConsumer& consumer) = delete;
+    BatchingConsumer& operator=(const BatchingConsumer& otherConsumer) = delete;
+
+    /*
+     * poll - Moves available elements from the source into the batch, and flushes the batch
+     * if one of the triggers fired and the rate limit allows it.
+     *
+     * @param handler - called with a std::span<T> of the batch when it is flushed.
+     * @param now - the current time.
+     * @return
+     * Returns true if a batch was flushed.
+     * @exception
+     * A random exception might be thrown by the handler, in which case the batch is kept and no tokens are taken.
+    */
+    template <class Handler>
+    bool poll(const Handler& handler, TimePoint now = Clock::now());
+
+    /*
+     * flush - Flushes the pending elements regardless of the size and latency triggers,
+     * for example on shutdown. The rate limit is not applied.
+     *
+     * @param handler - called with a std::span<T> of the batch, if it is not empty.
+     * @param now - the current time.
+     * @return
+     * Returns true if a batch was flushed.
+    */
+    template <class Handler>
+    bool flush(const Handler& handler, TimePoint now = Clock::now());
+
+    /*
+     * pending - the number of elements waiting in the batch.
+    */
+    int pending() const;
+
+    /*
+     * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+private:
+
+    Source& m_source;
+    T* m_batch;
+    int m_batchSize;
+    int m_maxBatchSize;
+    Duration m_maxLatency;
+    TimePoint m_oldestTime;
+
+    double m_elementsPerSecond;
+    double m_burstSize;
+    double m_tokens;
+    TimePoint m_lastRefill;
+
+    /*
+     * fill - moves elements from the source until the batch is full or the source is empty.
+    */
+    void fill(TimePoint now);
+
+    /*
+     * refillTokens - adds the tokens earned since the last refill, up to the burst size.
+    */
+    void refillTokens(TimePoint now);
+
+    /*
+     * handOver - gives the batch to the handler and empties it.
+    */
+    template <class Handler>
+    void handOver(const Handler& handler);
+};
+
+
+/* ------------------------------------ Public Functions of BatchingConsumer Class ------------------------------------*/
+
+template <class T, class Source, class Clock>
+BatchingConsumer<T, Source, Clock>::BatchingConsumer(Source& source, int maxBatchSize, Duration maxLatency,
+                                                      double elementsPerSecond, int burstSize) :
+    m_source(source), m_batch(nullptr), m_batchSize(0), m_maxBatchSize(maxBatchSize), m_maxLatency(maxLatency),
+    m_oldestTime(), m_elementsPerSecond(elementsPerSecond),
+    m_burstSize(burstSize > maxBatchSize ? burstSize : maxBatchSize), m_tokens(m_burstSize), m_lastRefill(Clock::now()) {
+
+    if(maxBatchSize <= 0){
+        throw InvalidArgument();
+    }
+    m_batch = new T[maxBatchSize];
+}
+
+template <class T, class Source, class Clock>
+BatchingConsumer<T, Source, Clock>::~BatchingConsumer(){
+    delete[] m_batch;
+}
+
+template <class T, class Source, class Clock>
+template <class Handler>
+bool BatchingConsumer<T, Source, Clock>::poll(const Handler& handler, TimePoint now){
+    fill(now);
+    if(m_batchSize == 0){
+        return false;
+    }
+    if(m_batchSize < m_maxBatchSize && now - m_oldestTime < m_maxLatency){
+        return false;
+    }
+
+    if(m_elementsPerSecond > 0){
+        refillTokens(now);
+        if(m_tokens < m_batchSize){
+            return false;
+        }
+    }
+    /* The tokens are taken only once the handler returned, so a batch that throws is not charged twice */
+    int batchSize = m_batchSize;
+    handOver(handler);
+    if(m_elementsPerSecond > 0){
+        m_tokens -= batchSize;
+    }
+    return true;
+}
+
+template <class T, class Source, class Clock>
+template <class Handler>
+bool BatchingConsumer<T, Source, Clock>::flush(const Handler& handler, TimePoint now){
+    fill(now);
+    if(m_batchSize == 0){
+        return false;
+    }
+    handOver(handler);
+    return true;
+}
+
+template <class T, class Source, class Clock>
+int BatchingConsumer<T, Source, Clock>::pending() const{
+    return m_batchSize;
+}
+
+/* --------------------------------- End of Public Functions of BatchingConsumer Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of BatchingConsumer Class ------------------------------------*/
+
+template <class T, class Source, class Clock>
+void BatchingConsumer<T, Source, Clock>::fill(TimePoint now){
+    int previousSize = m_batchSize;
+    while(m_batchSize < m_maxBatchSize && m_source.popFrontInto(m_batch[m_batchSize])){
+        m_batchSize++;
+    }
+    if(previousSize == 0 && m_batchSize > 0){
+        m_oldestTime = now;
+    }
+}
+
+template <class T, class Source, class Clock>
+void BatchingConsumer<T, Source, Clock>::refillTokens(TimePoint now){
+    if(now > m_lastRefill){
+        m_tokens += std::chrono::duration<double>(now - m_lastRefill).count() * m_elementsPerSecond;
+        if(m_tokens > m_burstSize){
+            m_tokens = m_burstSize;
+        }
+    }
+    m_lastRefill = now;
+}
+
+template <class T, class Source, class Clock>
+template <class Handler>
+void BatchingConsumer<T, Source, Clock>::handOver(const Handler& handler){
+    handler(std::span<T>(m_batch, m_batchSize));
+    m_batchSize = 0;
+}
+
+/* -------------------------------- End of Private Functions of BatchingConsumer Class --------------------------------*/
+
+#endif //BATCHING_CONSUMER_H
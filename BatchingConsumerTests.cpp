@@ -0,0 +1,102 @@
+#include <chrono>
+#include <span>
+#include <stdexcept>
+
+#include "BatchingConsumer.h"
+#include "ShardedQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace BatchingConsumerTests {
+
+typedef std::chrono::steady_clock::time_point TimePoint;
+typedef std::chrono::milliseconds Milliseconds;
+
+bool testFlushTriggers()
+{
+	bool testResult = true;
+
+	Queue<int> queue;
+	BatchingConsumer<int> consumer(queue, 4, Milliseconds(5));
+	Queue<int> flushedSizes;
+	int sum = 0;
+	auto handler = [&flushedSizes, &sum](std::span<int> batch) {
+		flushedSizes.pushBack(static_cast<int>(batch.size()));
+		for (int data : batch) {
+			sum += data;
+		}
+	};
+	TimePoint start;
+
+	for (int i = 1; i <= 6; i++) {
+		queue.pushBack(i);
+	}
+	/* size trigger */
+	AGREGATE_TEST_RESULT(testResult, consumer.poll(handler, start));
+	AGREGATE_TEST_RESULT(testResult, flushedSizes.size() == 1 && flushedSizes.front() == 4);
+
+	/* the remaining two elements wait for the latency trigger */
+	AGREGATE_TEST_RESULT(testResult, !consumer.poll(handler, start + Milliseconds(1)));
+	AGREGATE_TEST_RESULT(testResult, consumer.pending() == 2);
+	AGREGATE_TEST_RESULT(testResult, !consumer.poll(handler, start + Milliseconds(5)));
+	AGREGATE_TEST_RESULT(testResult, consumer.poll(handler, start + Milliseconds(6)));
+	AGREGATE_TEST_RESULT(testResult, flushedSizes.size() == 2 && sum == 21);
+
+	queue.pushBack(7);
+	AGREGATE_TEST_RESULT(testResult, consumer.flush(handler, start + Milliseconds(7)));
+	AGREGATE_TEST_RESULT(testResult, !consumer.flush(handler, start + Milliseconds(7)));
+	AGREGATE_TEST_RESULT(testResult, sum == 28 && consumer.pending() == 0);
+
+	return testResult;
+}
+
+bool testRateLimit()
+{
+	bool testResult = true;
+
+	ShardedQueue<int> queue(2);
+	/* 1000 elements per second with a bucket of 4 elements */
+	BatchingConsumer<int, ShardedQueue<int>> consumer(queue, 4, Milliseconds(0), 1000, 4);
+	int flushed = 0;
+	auto handler = [&flushed](std::span<int> batch) {
+		flushed += static_cast<int>(batch.size());
+	};
+	for (int i = 0; i < 12; i++) {
+		queue.pushBack(i);
+	}
+
+	TimePoint start;
+	AGREGATE_TEST_RESULT(testResult, consumer.poll(handler, start));
+	AGREGATE_TEST_RESULT(testResult, !consumer.poll(handler, start));
+	AGREGATE_TEST_RESULT(testResult, !consumer.poll(handler, start + Milliseconds(3)));
+	AGREGATE_TEST_RESULT(testResult, consumer.poll(handler, start + Milliseconds(4)));
+	AGREGATE_TEST_RESULT(testResult, flushed == 8);
+
+	/* a handler that throws takes no tokens, so the batch is retried within the same budget */
+	auto throwingHandler = [](std::span<int>) {
+		throw std::runtime_error("handler failed");
+	};
+	bool handlerThrew = false;
+	try {
+		consumer.poll(throwingHandler, start + Milliseconds(8));
+	}
+	catch (std::runtime_error& e) {
+		handlerThrew = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, handlerThrew && consumer.pending() == 4);
+	AGREGATE_TEST_RESULT(testResult, consumer.poll(handler, start + Milliseconds(8)) && flushed == 12);
+
+	bool exceptionThrown = false;
+	Queue<int> otherQueue;
+	try {
+		BatchingConsumer<int> invalidConsumer(otherQueue, 0, Milliseconds(1));
+	}
+	catch (BatchingConsumer<int>::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+}
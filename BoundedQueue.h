@@ -0,0 +1,257 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+
+/*
+ * BoundedQueue - Thread safe queue of fixed capacity. The circular array is allocated once by the
+ * constructor and never reallocated, so the memory use is known at startup.
+ * What happens when pushing to a full queue depends on the overflow policy:
+ *
+ * BLOCK       - pushBack waits until a consumer makes room.
+ * REJECT      - pushBack returns false and the element is not inserted.
+ * DROP_OLDEST - the first element is overwritten, and the new element is inserted at the end.
+ * DROP_NEWEST - the new element is silently discarded.
+*/
+template <class T>
+class BoundedQueue {
+
+public:
+
+    enum class OverflowPolicy { BLOCK, REJECT, DROP_OLDEST, DROP_NEWEST };
+
+    /*
+     * OverflowCounters - how many pushes found the queue full, by outcome.
+    */
+    struct OverflowCounters {
+        long long m_blocked = 0;
+        long long m_rejected = 0;
+        long long m_droppedOldest = 0;
+        long long m_droppedNewest = 0;
+    };
+
+    /*
+     * C'tor for BoundedQueue class.
+     *
+     * @param capacity - the maximal number of elements, must be positive.
+     * @param policy - what pushBack does when the queue is full.
+     * @return
+     * A new instance of BoundedQueue.
+     * @exception
+     * InvalidArgument exception if capacity is not positive,
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit BoundedQueue(int capacity, OverflowPolicy policy = OverflowPolicy::REJECT);
+
+    /*
+     * D'tor for BoundedQueue class.
+    */
+    ~BoundedQueue();
+
+    /*
+     * The queue is shared between threads by address, so copying is not allowed.
+    */
+    BoundedQueue(const BoundedQueue& queue) = delete;
+    BoundedQueue& operator=(const BoundedQueue& otherQueue) = delete;
+
+    /*
+     * pushBack - Inserts a new member at the end of the queue, applying the overflow policy if it is full.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+     * @return
+     * Returns false if the element was rejected (REJECT policy only), else true.
+     * @exception
+     * A random exception might be thrown by the assignment of T.
+    */
+    bool pushBack(const T& argumentToAdd);
+
+    /*
+     * popFront - Removes the first element in the queue.
+     *
+     * @exception
+     * EmptyQueue exception, in case the Queue is empty.
+    */
+    void popFront();
+
+    /*
+     * popFrontInto - Moves the first element in the queue into destination and removes it.
+     *
+     * @param destination - receives the first element.
+     * @return
+     * Returns true if an element was removed, false if the Queue is empty.
+    */
+    bool popFrontInto(T& destination);
+
+    /*
+     * tryPopFront - Removes the first element in the queue and returns it.
+     *
+     * @return
+     * Returns the removed element, or an empty optional if the Queue is empty.
+    */
+    std::optional<T> tryPopFront();
+
+    /*
+     * size - the number of elements in the queue.
+    */
+    int size() const;
+
+    /*
+     * capacity - the maximal number of elements in the queue.
+    */
+    int capacity() const;
+
+    /*
+     * counters - the overflow counters since construction.
+    */
+    OverflowCounters counters() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    class EmptyQueue {};
+
+    /*
+     * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+private:
+    T* m_data;
+    int m_capacity;
+    int m_firstIndex;
+    int m_size;
+    OverflowPolicy m_policy;
+    OverflowCounters m_counters;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notFull;
+
+    /*
+     * physicalIndex - position in the array of the element at the given place in the queue.
+    */
+    int physicalIndex(int index) const;
+
+    /*
+     * removeFront - moves the first element of a non empty queue into destination and removes it.
+     * Must be called with m_mutex held.
+    */
+    void removeFront(T& destination);
+};
+
+
+/* ------------------------------------ Public Functions of BoundedQueue Class ------------------------------------*/
+
+template <class T>
+BoundedQueue<T>::BoundedQueue(int capacity, OverflowPolicy policy) : m_data(nullptr), m_capacity(capacity),
+    m_firstIndex(0), m_size(0), m_policy(policy) {
+    if(capacity <= 0){
+        throw InvalidArgument();
+    }
+    m_data = new T[capacity];
+}
+
+template <class T>
+BoundedQueue<T>::~BoundedQueue(){
+    delete[] m_data;
+}
+
+template <class T>
+bool BoundedQueue<T>::pushBack(const T& argumentToAdd){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_size == m_capacity){
+        switch(m_policy){
+            case OverflowPolicy::BLOCK:
+                m_counters.m_blocked++;
+                m_notFull.wait(lock, [this]() { return m_size < m_capacity; });
+                break;
+            case OverflowPolicy::REJECT:
+                m_counters.m_rejected++;
+                return false;
+            case OverflowPolicy::DROP_OLDEST:
+                m_counters.m_droppedOldest++;
+                m_data[m_firstIndex] = argumentToAdd;
+                m_firstIndex = physicalIndex(1);
+                return true;
+            case OverflowPolicy::DROP_NEWEST:
+                m_counters.m_droppedNewest++;
+                return true;
+        }
+    }
+    m_data[physicalIndex(m_size)] = argumentToAdd;
+    m_size++;
+    return true;
+}
+
+template <class T>
+void BoundedQueue<T>::popFront(){
+    T destination;
+    if(!popFrontInto(destination)){
+        throw EmptyQueue();
+    }
+}
+
+template <class T>
+bool BoundedQueue<T>::popFrontInto(T& destination){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_size == 0){
+            return false;
+        }
+        removeFront(destination);
+    }
+    m_notFull.notify_one();
+    return true;
+}
+
+template <class T>
+std::optional<T> BoundedQueue<T>::tryPopFront(){
+    T result;
+    if(!popFrontInto(result)){
+        return std::nullopt;
+    }
+    return std::optional<T>(std::move(result));
+}
+
+template <class T>
+int BoundedQueue<T>::size() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+template <class T>
+int BoundedQueue<T>::capacity() const{
+    return m_capacity;
+}
+
+template <class T>
+typename BoundedQueue<T>::OverflowCounters BoundedQueue<T>::counters() const{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+/* --------------------------------- End of Public Functions of BoundedQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of BoundedQueue Class ------------------------------------*/
+
+template <class T>
+int BoundedQueue<T>::physicalIndex(int index) const{
+    int physical = m_firstIndex + index;
+    return physical < m_capacity ? physical : physical - m_capacity;
+}
+
+template <class T>
+void BoundedQueue<T>::removeFront(T& destination){
+    destination = std::move(m_data[m_firstIndex]);
+    m_firstIndex = physicalIndex(1);
+    m_size--;
+}
+
+/* -------------------------------- End of Private Functions of BoundedQueue Class --------------------------------*/
+
+#endif //BOUNDED_QUEUE_H
@@ -0,0 +1,90 @@
+#include <thread>
+
+#include "BoundedQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace BoundedQueueTests {
+
+typedef BoundedQueue<int>::OverflowPolicy OverflowPolicy;
+
+static bool checkContent(BoundedQueue<int>& queue, int first, int last)
+{
+	bool result = true;
+	for (int expected = first; expected <= last; expected++) {
+		std::optional<int> value = queue.tryPopFront();
+		result = result && value && (*value == expected);
+	}
+	return result && (queue.size() == 0);
+}
+
+bool testDropPolicies()
+{
+	bool testResult = true;
+
+	BoundedQueue<int> rejecting(3, OverflowPolicy::REJECT);
+	BoundedQueue<int> droppingOldest(3, OverflowPolicy::DROP_OLDEST);
+	BoundedQueue<int> droppingNewest(3, OverflowPolicy::DROP_NEWEST);
+	int rejected = 0;
+	for (int i = 1; i <= 5; i++) {
+		rejected += rejecting.pushBack(i) ? 0 : 1;
+		AGREGATE_TEST_RESULT(testResult, droppingOldest.pushBack(i));
+		AGREGATE_TEST_RESULT(testResult, droppingNewest.pushBack(i));
+	}
+	AGREGATE_TEST_RESULT(testResult, rejected == 2 && rejecting.counters().m_rejected == 2);
+	AGREGATE_TEST_RESULT(testResult, droppingOldest.counters().m_droppedOldest == 2);
+	AGREGATE_TEST_RESULT(testResult, droppingNewest.counters().m_droppedNewest == 2);
+	AGREGATE_TEST_RESULT(testResult, rejecting.size() == 3 && rejecting.capacity() == 3);
+
+	AGREGATE_TEST_RESULT(testResult, checkContent(rejecting, 1, 3));
+	AGREGATE_TEST_RESULT(testResult, checkContent(droppingOldest, 3, 5));
+	AGREGATE_TEST_RESULT(testResult, checkContent(droppingNewest, 1, 3));
+
+	bool exceptionThrown = false;
+	try {
+		rejecting.popFront();
+	}
+	catch (BoundedQueue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	exceptionThrown = false;
+	try {
+		BoundedQueue<int> invalidQueue(0);
+	}
+	catch (BoundedQueue<int>::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testBlockPolicy()
+{
+	bool testResult = true;
+
+	BoundedQueue<int> queue(4, OverflowPolicy::BLOCK);
+	std::thread producer([&queue]() {
+		for (int i = 1; i <= 1000; i++) {
+			queue.pushBack(i);
+		}
+	});
+
+	int expected = 1;
+	while (expected <= 1000) {
+		int value = 0;
+		if (queue.popFrontInto(value)) {
+			AGREGATE_TEST_RESULT(testResult, value == expected);
+			expected++;
+		}
+		AGREGATE_TEST_RESULT(testResult, queue.size() <= 4);
+	}
+	producer.join();
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 0);
+
+	return testResult;
+}
+
+}
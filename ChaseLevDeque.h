@@ -0,0 +1,222 @@
+#ifndef CHASE_LEV_DEQUE_H
+#define CHASE_LEV_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "Queue.h"
+
+
+/*
+ * ChaseLevDeque - Lock-free work-stealing deque (Chase & Lev, with the C11 orderings of Le et al.).
+ * A single owner thread pushes and pops at the back, any other thread may steal from the front.
+ * T must be trivially copyable (typically a pointer), since slots are accessed atomically.
+*/
+template <class T>
+class ChaseLevDeque {
+
+public:
+
+    /*
+     * C'tor for ChaseLevDeque class.
+     *
+     * @param initialCapacity - initial number of slots, rounded up to a power of two.
+     * @return
+     * A new instance of ChaseLevDeque.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit ChaseLevDeque(int initialCapacity = INITIAL_CAPACITY);
+
+    /*
+     * D'tor for ChaseLevDeque class.
+     * Frees the current slot array and every array retired by growth.
+    */
+    ~ChaseLevDeque();
+
+    /*
+     * The deque is shared between threads by address, so copying is not allowed.
+    */
+    ChaseLevDeque(const ChaseLevDeque& deque) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque& otherDeque) = delete;
+
+    /*
+     * pushBack - Inserts a new member at the back of the deque. Owner thread only.
+     *
+     * @param argumentToAdd - new member to add at the back of the deque.
+     * @exception
+     * std::bad_alloc exception might be thrown when the deque grows.
+    */
+    void pushBack(const T& argumentToAdd);
+
+    /*
+     * popBack - Removes the last member of the deque. Owner thread only.
+     *
+     * @param result - receives the removed member.
+     * @return
+     * Returns true if a member was removed, false if the deque was empty
+     * or the last member was stolen concurrently.
+    */
+    bool popBack(T& result);
+
+    /*
+     * stealFront - Removes the first member of the deque. May be called from any thread.
+     *
+     * @param result - receives the removed member.
+     * @return
+     * Returns true if a member was stolen, false if the deque was empty or another thief won the race.
+    */
+    bool stealFront(T& result);
+
+    /*
+     * size - the number of elements in the deque.
+     *
+     * @return
+     * Returns an approximation of the number of elements, exact when no other thread is active.
+    */
+    int size() const;
+
+private:
+
+    /*
+     * Array - circular slot array with a power of two capacity.
+    */
+    struct Array {
+        std::int64_t m_capacity;
+        std::atomic<T>* m_slots;
+
+        explicit Array(std::int64_t capacity) : m_capacity(capacity), m_slots(new std::atomic<T>[capacity]) {}
+        ~Array() { delete[] m_slots; }
+
+        T get(std::int64_t index) const { return m_slots[index & (m_capacity - 1)].load(std::memory_order_relaxed); }
+        void put(std::int64_t index, const T& value) { m_slots[index & (m_capacity - 1)].store(value, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<std::int64_t> m_top;
+    alignas(64) std::atomic<std::int64_t> m_bottom;
+    alignas(64) std::atomic<Array*> m_array;
+
+    /* Arrays replaced by growth. Thieves may still read them, so they live as long as the deque */
+    Queue<Array*> m_retiredArrays;
+
+    /* The initial number of slots of a deque */
+    static const int INITIAL_CAPACITY = 1024;
+
+    /*
+     * grow - doubles the slot array, copying the live range [top, bottom).
+     *
+     * @return
+     * Returns the new array.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    Array* grow(Array* array, std::int64_t bottom, std::int64_t top);
+};
+
+
+/* ------------------------------------ Public Functions of ChaseLevDeque Class ------------------------------------*/
+
+template <class T>
+ChaseLevDeque<T>::ChaseLevDeque(int initialCapacity) : m_top(0), m_bottom(0), m_array(nullptr) {
+    std::int64_t capacity = 1;
+    while(capacity < initialCapacity){
+        capacity *= 2;
+    }
+    m_array.store(new Array(capacity), std::memory_order_relaxed);
+}
+
+template <class T>
+ChaseLevDeque<T>::~ChaseLevDeque(){
+    delete m_array.load(std::memory_order_relaxed);
+    for(Array* array : m_retiredArrays){
+        delete array;
+    }
+}
+
+template <class T>
+void ChaseLevDeque<T>::pushBack(const T& argumentToAdd){
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    Array* array = m_array.load(std::memory_order_relaxed);
+    if(bottom - top > array->m_capacity - 1){
+        array = grow(array, bottom, top);
+    }
+    array->put(bottom, argumentToAdd);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <class T>
+bool ChaseLevDeque<T>::popBack(T& result){
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Array* array = m_array.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if(top > bottom){
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    result = array->get(bottom);
+    if(top < bottom){
+        return true;
+    }
+
+    /* Last element - race against the thieves for it */
+    bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template <class T>
+bool ChaseLevDeque<T>::stealFront(T& result){
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if(top >= bottom){
+        return false;
+    }
+
+    /* Acquire stands in for consume, which compilers promote to acquire anyway */
+    Array* array = m_array.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+        return false;
+    }
+    result = value;
+    return true;
+}
+
+template <class T>
+int ChaseLevDeque<T>::size() const{
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<int>(bottom - top) : 0;
+}
+
+/* --------------------------------- End of Public Functions of ChaseLevDeque Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of ChaseLevDeque Class ------------------------------------*/
+
+template <class T>
+typename ChaseLevDeque<T>::Array* ChaseLevDeque<T>::grow(Array* array, std::int64_t bottom, std::int64_t top){
+    Array* newArray = new Array(array->m_capacity * 2);
+    try{
+        m_retiredArrays.pushBack(array);
+    } catch(...){
+        delete newArray;
+        throw;
+    }
+    for(std::int64_t i = top ; i < bottom ; i++){
+        newArray->put(i, array->get(i));
+    }
+    m_array.store(newArray, std::memory_order_release);
+    return newArray;
+}
+
+/* -------------------------------- End of Private Functions of ChaseLevDeque Class --------------------------------*/
+
+#endif //CHASE_LEV_DEQUE_H
@@ -0,0 +1,411 @@
+#ifndef COMPRESSED_QUEUE_H
+#define COMPRESSED_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Queue.h"
+
+
+/*
+ * CompressedQueue - Queue of integers that stores full blocks of BLOCK_SIZE elements bit-packed.
+ * pushBack appends to an open block of plain values, which is packed when it is full, and popFront
+ * unpacks the first packed block when the elements before it run out.
+ *
+ * A block is packed with frame of reference - every value as its distance from the smallest value, in as
+ * many bits as the largest distance needs - either of the values themselves or of their deltas, whichever
+ * takes fewer bits, so increasing IDs take a few bits each and small values take a few bits whatever their order.
+ *
+ * The packed words of a block are interleaved over LANES lanes: value i is in lane i % LANES, and word k of
+ * every lane is stored next to word k of the other lanes. Packing and unpacking then shift LANES neighbouring
+ * words by the same amount at every step, which the compiler turns into vector instructions, and the deltas
+ * are taken between values LANES apart so they are summed back a whole row at a time as well.
+*/
+template <class T>
+class CompressedQueue {
+
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "CompressedQueue requires an integral type");
+
+public:
+
+    /* The packed words, wide enough for the difference of any two values of T */
+    typedef typename std::conditional<sizeof(T) <= sizeof(std::uint32_t), std::uint32_t, std::uint64_t>::type Word;
+
+    static const int WORD_BITS = static_cast<int>(sizeof(Word)) * 8;
+    static const int LANES = 8;
+    static const int BLOCK_SIZE = LANES * WORD_BITS;
+
+    /*
+     * C'tor for CompressedQueue class.
+     *
+     * @return
+     * A new, empty instance of CompressedQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    CompressedQueue();
+
+    /*
+     * D'tor for CompressedQueue class.
+    */
+    ~CompressedQueue() = default;
+
+    /*
+     * Copy C'tor and assignment operator, copy the packed blocks as they are.
+    */
+    CompressedQueue(const CompressedQueue& queue) = default;
+    CompressedQueue& operator=(const CompressedQueue& otherQueue) = default;
+
+    /*
+     * pushBack - Inserts a new member at the end of the queue, packing the open block if it becomes full.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is unchanged.
+    */
+    void pushBack(T argumentToAdd);
+
+    /*
+     * front - Returns the first element in the queue.
+     *
+     * @return
+     * Returns the value of the first element.
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    T front() const;
+
+    /*
+     * popFront - Removes the first element in the queue, unpacking the next block if needed.
+     *
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    void popFront();
+
+    /*
+     * popFrontInto - Copies the first element in the queue into destination and removes it.
+     *
+     * @param destination - receives the first element.
+     * @return
+     * Returns true if an element was removed, false if the queue is empty.
+    */
+    bool popFrontInto(T& destination);
+
+    /*
+     * forEach - calls function on the value of every element in order, unpacking one block at a time.
+     *
+     * @param function - called as function(value).
+     * @exception
+     * A random exception might be thrown by function.
+    */
+    template <class Function>
+    void forEach(const Function& function) const;
+
+    /*
+     * size - the number of elements in the queue.
+    */
+    int size() const;
+
+    /*
+     * compressedBytes - the bytes used by the queue: the object itself, with its unpacked first block and
+     * open last block, and the packed blocks. The spare capacity of the queues of packed blocks is not counted.
+    */
+    std::size_t compressedBytes() const;
+
+    /*
+     * compressionRatio - the size of the elements as plain values, divided by compressedBytes.
+    */
+    double compressionRatio() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    typedef typename Queue<T>::EmptyQueue EmptyQueue;
+
+private:
+
+    /*
+     * Block - header of a packed block, its bitWidth * LANES words are in m_words, after m_skip words left
+     * behind by a seal that failed.
+     * The values, or the deltas if m_delta, are m_base plus the packed distances, and the deltas are added
+     * to m_first for the first row.
+    */
+    struct Block {
+        Word m_base;
+        Word m_first;
+        unsigned char m_bitWidth;
+        bool m_delta;
+        unsigned short m_skip;
+    };
+
+    Queue<Block> m_blocks;
+    Queue<Word> m_words;
+    int m_packedWords;
+    T m_head[BLOCK_SIZE];
+    int m_headIndex;
+    int m_headCount;
+    T m_tail[BLOCK_SIZE];
+    int m_tailCount;
+    int m_size;
+
+    /*
+     * seal - packs the full open block and appends it to m_blocks and m_words.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is unchanged.
+    */
+    void seal();
+
+    /*
+     * refill - fills the empty first block, with the next packed block or else with the open block.
+    */
+    void refill() noexcept;
+
+    /*
+     * unpack - unpacks the packed words of a block into BLOCK_SIZE values.
+    */
+    static void unpack(const Block& block, const Word* packed, T* values) noexcept;
+
+    /*
+     * bitWidth - the number of bits needed for the value.
+    */
+    static int bitWidth(Word value) noexcept;
+};
+
+
+/* ------------------------------------ Public Functions of CompressedQueue Class ------------------------------------*/
+
+template <class T>
+CompressedQueue<T>::CompressedQueue() : m_blocks(), m_words(), m_packedWords(0), m_headIndex(0), m_headCount(0),
+    m_tailCount(0), m_size(0) {}
+
+template <class T>
+void CompressedQueue<T>::pushBack(T argumentToAdd){
+    if(m_tailCount == BLOCK_SIZE){
+        seal();
+    }
+    m_tail[m_tailCount++] = argumentToAdd;
+    m_size++;
+    if(m_headIndex == m_headCount){
+        refill();
+    }
+}
+
+template <class T>
+T CompressedQueue<T>::front() const{
+    if(m_size == 0){
+        throw EmptyQueue();
+    }
+    return m_head[m_headIndex];
+}
+
+template <class T>
+void CompressedQueue<T>::popFront(){
+    if(m_size == 0){
+        throw EmptyQueue();
+    }
+    m_headIndex++;
+    m_size--;
+    if(m_headIndex == m_headCount){
+        refill();
+    }
+}
+
+template <class T>
+bool CompressedQueue<T>::popFrontInto(T& destination){
+    if(m_size == 0){
+        return false;
+    }
+    destination = m_head[m_headIndex];
+    popFront();
+    return true;
+}
+
+template <class T>
+template <class Function>
+void CompressedQueue<T>::forEach(const Function& function) const{
+    for(int i = m_headIndex ; i < m_headCount ; i++){
+        function(m_head[i]);
+    }
+    Word packed[WORD_BITS * LANES];
+    T values[BLOCK_SIZE];
+    int wordIndex = 0;
+    for(const Block& block : m_blocks){
+        wordIndex += block.m_skip;
+        int numberOfWords = block.m_bitWidth * LANES;
+        for(int i = 0 ; i < numberOfWords ; i++){
+            packed[i] = m_words[wordIndex + i];
+        }
+        wordIndex += numberOfWords;
+        unpack(block, packed, values);
+        for(int i = 0 ; i < BLOCK_SIZE ; i++){
+            function(values[i]);
+        }
+    }
+    for(int i = 0 ; i < m_tailCount ; i++){
+        function(m_tail[i]);
+    }
+}
+
+template <class T>
+int CompressedQueue<T>::size() const{
+    return m_size;
+}
+
+template <class T>
+std::size_t CompressedQueue<T>::compressedBytes() const{
+    return sizeof(*this) + m_blocks.size() * sizeof(Block) + m_words.size() * sizeof(Word);
+}
+
+template <class T>
+double CompressedQueue<T>::compressionRatio() const{
+    return static_cast<double>(m_size) * sizeof(T) / static_cast<double>(compressedBytes());
+}
+
+/* --------------------------------- End of Public Functions of CompressedQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of CompressedQueue Class ------------------------------------*/
+
+template <class T>
+void CompressedQueue<T>::seal(){
+    /* Frame of reference of the values, with the smallest value in the order of T */
+    T minimum = m_tail[0];
+    for(int i = 1 ; i < BLOCK_SIZE ; i++){
+        minimum = m_tail[i] < minimum ? m_tail[i] : minimum;
+    }
+    Word distances[BLOCK_SIZE];
+    Word valueBits = 0;
+    for(int i = 0 ; i < BLOCK_SIZE ; i++){
+        distances[i] = static_cast<Word>(m_tail[i]) - static_cast<Word>(minimum);
+        valueBits |= distances[i];
+    }
+
+    /* Frame of reference of the deltas between values LANES apart, with the smallest delta as a signed number */
+    typedef typename std::make_signed<Word>::type SignedWord;
+    Word deltas[BLOCK_SIZE];
+    Word first = static_cast<Word>(m_tail[0]);
+    for(int i = 0 ; i < BLOCK_SIZE ; i++){
+        deltas[i] = static_cast<Word>(m_tail[i]) - (i < LANES ? first : static_cast<Word>(m_tail[i - LANES]));
+    }
+    Word minimumDelta = deltas[0];
+    for(int i = 1 ; i < BLOCK_SIZE ; i++){
+        minimumDelta = static_cast<SignedWord>(deltas[i]) < static_cast<SignedWord>(minimumDelta) ? deltas[i] : minimumDelta;
+    }
+    Word deltaBits = 0;
+    for(int i = 0 ; i < BLOCK_SIZE ; i++){
+        deltas[i] -= minimumDelta;
+        deltaBits |= deltas[i];
+    }
+
+    Block block;
+    block.m_delta = bitWidth(deltaBits) < bitWidth(valueBits);
+    block.m_base = block.m_delta ? minimumDelta : static_cast<Word>(minimum);
+    block.m_first = first;
+    block.m_bitWidth = static_cast<unsigned char>(block.m_delta ? bitWidth(deltaBits) : bitWidth(valueBits));
+    block.m_skip = static_cast<unsigned short>(m_words.size() - m_packedWords);
+    const Word* offsets = block.m_delta ? deltas : distances;
+
+    int width = block.m_bitWidth;
+    Word packed[WORD_BITS * LANES] = {};
+    for(int row = 0 ; row < WORD_BITS ; row++){
+        int bit = row * width;
+        int word = bit / WORD_BITS;
+        int shift = bit % WORD_BITS;
+        for(int lane = 0 ; lane < LANES ; lane++){
+            packed[word * LANES + lane] |= offsets[row * LANES + lane] << shift;
+        }
+        if(shift + width > WORD_BITS){
+            for(int lane = 0 ; lane < LANES ; lane++){
+                packed[(word + 1) * LANES + lane] |= offsets[row * LANES + lane] >> (WORD_BITS - shift);
+            }
+        }
+    }
+
+    /* If this throws, the words already pushed are not counted in m_packedWords, and the next block skips them */
+    for(int i = 0 ; i < width * LANES ; i++){
+        m_words.pushBack(packed[i]);
+    }
+    m_blocks.pushBack(block);
+    m_packedWords = m_words.size();
+    m_tailCount = 0;
+}
+
+template <class T>
+void CompressedQueue<T>::refill() noexcept{
+    m_headIndex = 0;
+    if(m_blocks.size() > 0){
+        const Block& block = m_blocks.front();
+        Word packed[WORD_BITS * LANES];
+        for(int i = 0 ; i < block.m_skip ; i++){
+            m_words.popFrontInto(packed[0]);
+        }
+        int numberOfWords = block.m_bitWidth * LANES;
+        for(int i = 0 ; i < numberOfWords ; i++){
+            m_words.popFrontInto(packed[i]);
+        }
+        m_packedWords -= block.m_skip + numberOfWords;
+        unpack(block, packed, m_head);
+        m_blocks.popFront();
+        m_headCount = BLOCK_SIZE;
+        return;
+    }
+    for(int i = 0 ; i < m_tailCount ; i++){
+        m_head[i] = m_tail[i];
+    }
+    m_headCount = m_tailCount;
+    m_tailCount = 0;
+}
+
+template <class T>
+void CompressedQueue<T>::unpack(const Block& block, const Word* packed, T* values) noexcept{
+    int width = block.m_bitWidth;
+    Word mask = width == WORD_BITS ? ~static_cast<Word>(0) : (static_cast<Word>(1) << width) - 1;
+    Word offsets[BLOCK_SIZE] = {};
+    for(int row = 0 ; width > 0 && row < WORD_BITS ; row++){
+        int bit = row * width;
+        int word = bit / WORD_BITS;
+        int shift = bit % WORD_BITS;
+        for(int lane = 0 ; lane < LANES ; lane++){
+            offsets[row * LANES + lane] = packed[word * LANES + lane] >> shift;
+        }
+        if(shift + width > WORD_BITS){
+            for(int lane = 0 ; lane < LANES ; lane++){
+                offsets[row * LANES + lane] |= packed[(word + 1) * LANES + lane] << (WORD_BITS - shift);
+            }
+        }
+    }
+
+    if(!block.m_delta){
+        for(int i = 0 ; i < BLOCK_SIZE ; i++){
+            values[i] = static_cast<T>((offsets[i] & mask) + block.m_base);
+        }
+        return;
+    }
+    Word previous[LANES];
+    for(int lane = 0 ; lane < LANES ; lane++){
+        previous[lane] = block.m_first;
+    }
+    for(int row = 0 ; row < WORD_BITS ; row++){
+        for(int lane = 0 ; lane < LANES ; lane++){
+            previous[lane] += (offsets[row * LANES + lane] & mask) + block.m_base;
+            values[row * LANES + lane] = static_cast<T>(previous[lane]);
+        }
+    }
+}
+
+template <class T>
+int CompressedQueue<T>::bitWidth(Word value) noexcept{
+    int width = 0;
+    for( ; value != 0 ; value >>= 1){
+        width++;
+    }
+    return width;
+}
+
+/* -------------------------------- End of Private Functions of CompressedQueue Class --------------------------------*/
+
+#endif //COMPRESSED_QUEUE_H
@@ -0,0 +1,107 @@
+#include <climits>
+
+#include "CompressedQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace CompressedQueueTests {
+
+/* Pushes the values, and checks that forEach and popping return them in order */
+template <class T>
+static bool roundTrip(const Queue<T>& values)
+{
+	bool testResult = true;
+
+	CompressedQueue<T> queue;
+	for (T value : values) {
+		queue.pushBack(value);
+	}
+	AGREGATE_TEST_RESULT(testResult, queue.size() == values.size());
+
+	int index = 0;
+	queue.forEach([&](T value) {
+		AGREGATE_TEST_RESULT(testResult, value == values[index++]);
+	});
+	AGREGATE_TEST_RESULT(testResult, index == values.size());
+
+	CompressedQueue<T> copy = queue;
+	T value = T();
+	for (index = 0; copy.popFrontInto(value); index++) {
+		AGREGATE_TEST_RESULT(testResult, value == values[index]);
+	}
+	AGREGATE_TEST_RESULT(testResult, index == values.size() && copy.size() == 0);
+	return testResult;
+}
+
+bool testRoundTrip()
+{
+	bool testResult = true;
+
+	Queue<int> increasing;
+	Queue<int> mixed;
+	unsigned seed = 12345;
+	for (int i = 0; i < 2000; i++) {
+		increasing.pushBack(1000000 + 3 * i);
+		seed = seed * 1103515245 + 12345;
+		mixed.pushBack(i % 97 == 0 ? (i % 2 == 0 ? INT_MIN : INT_MAX) : static_cast<int>(seed));
+	}
+	AGREGATE_TEST_RESULT(testResult, roundTrip(increasing));
+	AGREGATE_TEST_RESULT(testResult, roundTrip(mixed));
+
+	Queue<long long> wide;
+	Queue<short> narrow;
+	for (int i = 0; i < 1500; i++) {
+		wide.pushBack(i % 3 == 0 ? LLONG_MIN + i : LLONG_MAX - 7 * i);
+		narrow.pushBack(static_cast<short>(i % 40 - 20));
+	}
+	AGREGATE_TEST_RESULT(testResult, roundTrip(wide));
+	AGREGATE_TEST_RESULT(testResult, roundTrip(narrow));
+
+	/* popping while pushing moves the front through packed blocks and the open block */
+	CompressedQueue<unsigned> queue;
+	unsigned next = 0;
+	unsigned expected = 0;
+	for (int round = 0; round < 50; round++) {
+		for (int i = 0; i < 97; i++) {
+			queue.pushBack(next++);
+		}
+		for (int i = 0; i < 60; i++) {
+			AGREGATE_TEST_RESULT(testResult, queue.front() == expected);
+			queue.popFront();
+			expected++;
+		}
+	}
+	AGREGATE_TEST_RESULT(testResult, queue.size() == static_cast<int>(next - expected));
+
+	bool exceptionThrown = false;
+	CompressedQueue<int> emptyQueue;
+	try {
+		emptyQueue.popFront();
+	}
+	catch (CompressedQueue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testCompressionRatio()
+{
+	bool testResult = true;
+
+	CompressedQueue<int> ids;
+	CompressedQueue<int> smallValues;
+	for (int i = 0; i < 100000; i++) {
+		ids.pushBack(5000000 + i);
+		smallValues.pushBack((i * 7) % 13);
+	}
+	/* the lane deltas of consecutive IDs are 0..8, and values below 16 are packed as they are, 4 bits each */
+	AGREGATE_TEST_RESULT(testResult, ids.compressionRatio() > 6.0);
+	AGREGATE_TEST_RESULT(testResult, smallValues.compressionRatio() > 6.0);
+	AGREGATE_TEST_RESULT(testResult, ids.compressedBytes() * 6 < 100000 * sizeof(int));
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,318 @@
+#ifndef COPY_ON_WRITE_QUEUE_H
+#define COPY_ON_WRITE_QUEUE_H
+
+#include <atomic>
+
+#include "Queue.h"
+
+
+/*
+ * CopyOnWriteQueue - Queue<T> whose copies share one reference counted Queue until one of them is modified.
+ * Copying is O(1), and the first mutating call on a shared copy (pushBack, popFront, the non-const front,
+ * begin and end) detaches it by copying the elements once.
+ *
+ * This makes a copy a cheap, consistent snapshot: a writer may hand a copy to a reader thread and keep
+ * pushing, while the reader iterates the state at the time of the copy.
+ * A single CopyOnWriteQueue object is not thread safe - different threads must work on different copies.
+ * Writing through a reference or Iterator taken before the queue was copied writes to the shared elements,
+ * so take them again after copying.
+*/
+template <class T>
+class CopyOnWriteQueue {
+
+public:
+
+    typedef typename Queue<T>::Iterator Iterator;
+    typedef typename Queue<T>::ConstIterator ConstIterator;
+
+    /*
+     * C'tor for CopyOnWriteQueue class.
+     *
+     * @return
+     * A new, empty instance of CopyOnWriteQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    CopyOnWriteQueue();
+
+    /*
+     * C'tor of a CopyOnWriteQueue holding a copy of the elements of a Queue.
+     *
+     * @param queue - the elements to copy.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the assignment of T.
+    */
+    explicit CopyOnWriteQueue(const Queue<T>& queue);
+
+    /*
+     * Copy C'tor for CopyOnWriteQueue class, O(1).
+     *
+     * @param queue - The queue to share the elements of.
+    */
+    CopyOnWriteQueue(const CopyOnWriteQueue& queue) noexcept;
+
+    /*
+     * Assignment operator for CopyOnWriteQueue class, O(1).
+     *
+     * @param otherQueue - The queue to share the elements of.
+     * @return
+     * Reference to the updated queue.
+    */
+    CopyOnWriteQueue& operator=(const CopyOnWriteQueue& otherQueue) noexcept;
+
+    /*
+     * D'tor for CopyOnWriteQueue class.
+    */
+    ~CopyOnWriteQueue();
+
+    /*
+     * pushBack - Inserts a new member at the end of the queue, detaching it first if it is shared.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown.
+    */
+    void pushBack(const T& argumentToAdd);
+
+    /*
+     * front - Returns the first element in the queue, detaching it first if it is shared.
+     *
+     * @return
+     * Returns a reference to the first element.
+     * @exception
+     * EmptyQueue exception, in case the queue is empty,
+     * std::bad_alloc exception might be thrown.
+    */
+    T& front();
+
+    /*
+     * front - Returns the first element in the queue, without detaching it.
+     *
+     * @return
+     * Returns a const reference to the first element.
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    const T& front() const;
+
+    /*
+     * popFront - Removes the first element in the queue, detaching it first if it is shared.
+     *
+     * @exception
+     * EmptyQueue exception, in case the queue is empty,
+     * std::bad_alloc exception might be thrown.
+    */
+    void popFront();
+
+    /*
+     * popFrontInto - Moves the first element in the queue into destination and removes it,
+     * detaching the queue first if it is shared.
+     *
+     * @param destination - receives the first element.
+     * @return
+     * Returns true if an element was removed, false if the queue is empty.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    bool popFrontInto(T& destination);
+
+    /*
+     * size - the number of elements in the queue.
+    */
+    int size() const;
+
+    /*
+     * isShared - checks if the elements are shared with another copy.
+    */
+    bool isShared() const;
+
+    /*
+     * queue - read only view of the elements, for the free functions of Queue such as filter.
+    */
+    const Queue<T>& queue() const;
+
+    /*
+     * begin - begin iterator, detaching the queue first if it is shared.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    Iterator begin();
+
+    /*
+     * end - end iterator, detaching the queue first if it is shared.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    Iterator end();
+
+    /*
+     * begin - begin iterator, without detaching the queue.
+    */
+    ConstIterator begin() const;
+
+    /*
+     * end - end iterator, without detaching the queue.
+    */
+    ConstIterator end() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    typedef typename Queue<T>::EmptyQueue EmptyQueue;
+
+private:
+
+    /*
+     * SharedData - the shared Queue and the number of copies that refer to it.
+    */
+    struct SharedData {
+        std::atomic<int> m_references;
+        Queue<T> m_queue;
+
+        SharedData() : m_references(1), m_queue() {}
+        explicit SharedData(const Queue<T>& queue) : m_references(1), m_queue(queue) {}
+    };
+
+    SharedData* m_shared;
+
+    /*
+     * detach - gives this copy a Queue of its own if the current one is shared.
+     *
+     * @return
+     * Returns the Queue to modify.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is still shared.
+    */
+    Queue<T>& detach();
+
+    /*
+     * release - drops this copy's reference, and deletes the shared data if it was the last one.
+    */
+    static void release(SharedData* shared) noexcept;
+};
+
+
+/* ------------------------------------ Public Functions of CopyOnWriteQueue Class ------------------------------------*/
+
+template <class T>
+CopyOnWriteQueue<T>::CopyOnWriteQueue() : m_shared(new SharedData()) {}
+
+template <class T>
+CopyOnWriteQueue<T>::CopyOnWriteQueue(const Queue<T>& queue) : m_shared(new SharedData(queue)) {}
+
+template <class T>
+CopyOnWriteQueue<T>::CopyOnWriteQueue(const CopyOnWriteQueue& queue) noexcept : m_shared(queue.m_shared) {
+    m_shared->m_references.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <class T>
+CopyOnWriteQueue<T>& CopyOnWriteQueue<T>::operator=(const CopyOnWriteQueue& otherQueue) noexcept{
+    otherQueue.m_shared->m_references.fetch_add(1, std::memory_order_relaxed);
+    release(m_shared);
+    m_shared = otherQueue.m_shared;
+    return *this;
+}
+
+template <class T>
+CopyOnWriteQueue<T>::~CopyOnWriteQueue(){
+    release(m_shared);
+}
+
+template <class T>
+void CopyOnWriteQueue<T>::pushBack(const T& argumentToAdd){
+    detach().pushBack(argumentToAdd);
+}
+
+template <class T>
+T& CopyOnWriteQueue<T>::front(){
+    if(m_shared->m_queue.size() == 0){
+        throw EmptyQueue();
+    }
+    return detach().front();
+}
+
+template <class T>
+const T& CopyOnWriteQueue<T>::front() const{
+    return static_cast<const Queue<T>&>(m_shared->m_queue).front();
+}
+
+template <class T>
+void CopyOnWriteQueue<T>::popFront(){
+    if(m_shared->m_queue.size() == 0){
+        throw EmptyQueue();
+    }
+    detach().popFront();
+}
+
+template <class T>
+bool CopyOnWriteQueue<T>::popFrontInto(T& destination){
+    if(m_shared->m_queue.size() == 0){
+        return false;
+    }
+    return detach().popFrontInto(destination);
+}
+
+template <class T>
+int CopyOnWriteQueue<T>::size() const{
+    return m_shared->m_queue.size();
+}
+
+template <class T>
+bool CopyOnWriteQueue<T>::isShared() const{
+    return m_shared->m_references.load(std::memory_order_acquire) > 1;
+}
+
+template <class T>
+const Queue<T>& CopyOnWriteQueue<T>::queue() const{
+    return m_shared->m_queue;
+}
+
+template <class T>
+typename CopyOnWriteQueue<T>::Iterator CopyOnWriteQueue<T>::begin(){
+    return detach().begin();
+}
+
+template <class T>
+typename CopyOnWriteQueue<T>::Iterator CopyOnWriteQueue<T>::end(){
+    return detach().end();
+}
+
+template <class T>
+typename CopyOnWriteQueue<T>::ConstIterator CopyOnWriteQueue<T>::begin() const{
+    return static_cast<const Queue<T>&>(m_shared->m_queue).begin();
+}
+
+template <class T>
+typename CopyOnWriteQueue<T>::ConstIterator CopyOnWriteQueue<T>::end() const{
+    return static_cast<const Queue<T>&>(m_shared->m_queue).end();
+}
+
+/* --------------------------------- End of Public Functions of CopyOnWriteQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of CopyOnWriteQueue Class ------------------------------------*/
+
+template <class T>
+Queue<T>& CopyOnWriteQueue<T>::detach(){
+    /* Acquire pairs with the release of the other copies, so their reads are done before this copy writes */
+    if(m_shared->m_references.load(std::memory_order_acquire) > 1){
+        SharedData* shared = new SharedData(m_shared->m_queue);
+        release(m_shared);
+        m_shared = shared;
+    }
+    return m_shared->m_queue;
+}
+
+template <class T>
+void CopyOnWriteQueue<T>::release(SharedData* shared) noexcept{
+    if(shared->m_references.fetch_sub(1, std::memory_order_acq_rel) == 1){
+        delete shared;
+    }
+}
+
+/* -------------------------------- End of Private Functions of CopyOnWriteQueue Class --------------------------------*/
+
+#endif //COPY_ON_WRITE_QUEUE_H
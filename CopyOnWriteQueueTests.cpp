@@ -0,0 +1,78 @@
+#include <thread>
+
+#include "CopyOnWriteQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace CopyOnWriteQueueTests {
+
+bool testSnapshots()
+{
+	bool testResult = true;
+
+	CopyOnWriteQueue<int> queue;
+	for (int i = 1; i <= 5; i++) {
+		queue.pushBack(i);
+	}
+	const CopyOnWriteQueue<int> snapshot = queue;
+	AGREGATE_TEST_RESULT(testResult, queue.isShared() && snapshot.isShared());
+	AGREGATE_TEST_RESULT(testResult, &snapshot.queue() == &queue.queue() && snapshot.front() == 1);
+
+	queue.popFront();
+	queue.pushBack(6);
+	AGREGATE_TEST_RESULT(testResult, !queue.isShared() && !snapshot.isShared());
+	AGREGATE_TEST_RESULT(testResult, snapshot.size() == 5 && snapshot.front() == 1 && queue.front() == 2);
+
+	CopyOnWriteQueue<int> copy(snapshot);
+	copy = queue;
+	for (int& value : copy) {
+		value *= 10;
+	}
+	int expected = 2;
+	for (int value : queue) {
+		AGREGATE_TEST_RESULT(testResult, value == expected++);
+	}
+	AGREGATE_TEST_RESULT(testResult, copy.front() == 20 && filter(copy.queue(), [](int value) { return value > 40; }).size() == 2);
+
+	int value = 0;
+	AGREGATE_TEST_RESULT(testResult, copy.popFrontInto(value) && value == 20 && copy.size() == 4);
+
+	CopyOnWriteQueue<int> empty;
+	bool exceptionThrown = false;
+	try {
+		empty.popFront();
+	}
+	catch (CopyOnWriteQueue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown && !empty.popFrontInto(value));
+
+	return testResult;
+}
+
+bool testReaderThread()
+{
+	bool testResult = true;
+
+	CopyOnWriteQueue<int> queue;
+	for (int i = 0; i < 1000; i++) {
+		queue.pushBack(i);
+	}
+	CopyOnWriteQueue<int> snapshot = queue;
+	long long readerSum = 0;
+	std::thread reader([&readerSum, snapshot]() {
+		for (int value : snapshot) {
+			readerSum += value;
+		}
+	});
+	for (int i = 0; i < 1000; i++) {
+		queue.popFront();
+		queue.pushBack(-i);
+	}
+	reader.join();
+	AGREGATE_TEST_RESULT(testResult, readerSum == 999 * 1000 / 2 && queue.front() == 0 && queue.size() == 1000);
+
+	return testResult;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "HealthPoints.h"
+#include "QueueTrace.h"
 #include <iostream>
 
 
@@ -14,6 +15,9 @@ HealthPoints::HealthPoints(int maxHP) {
 
 }
 
+HealthPoints::HealthPoints(int maxHP, int currentHP) : m_maxHP(maxHP), m_currentHP(currentHP) {
+}
+
 
 void HealthPoints::handleHealthPointsEdge(){
     if(m_currentHP > m_maxHP){
@@ -26,14 +30,18 @@ void HealthPoints::handleHealthPointsEdge(){
 
 
 HealthPoints& HealthPoints::operator+=(int hpToAdd){
+    [[maybe_unused]] int previousHP = m_currentHP;
     m_currentHP += hpToAdd;
     this->handleHealthPointsEdge();
+    QUEUE_TRACE_THRESHOLD(this, previousHP, m_currentHP);
     return *this;
 }
 
 HealthPoints& HealthPoints::operator-=(int hpToDecrease){
+    [[maybe_unused]] int previousHP = m_currentHP;
     m_currentHP -= hpToDecrease;
     this->handleHealthPointsEdge();
+    QUEUE_TRACE_THRESHOLD(this, previousHP, m_currentHP);
     return *this;
 }
 
@@ -60,6 +68,9 @@ bool operator!=(const HealthPoints& healthPoints1, const HealthPoints& healthPoi
 bool operator<(const HealthPoints& healthPoints1, const HealthPoints& healthPoints2){
     return(healthPoints1.m_currentHP < healthPoints2.m_currentHP);
 }
+int radixKey(const HealthPoints& healthPoints){
+    return healthPoints.m_currentHP;
+}
 bool operator<=(const HealthPoints& healthPoints1, const HealthPoints& healthPoints2){
     return !(healthPoints1 > healthPoints2);
 }
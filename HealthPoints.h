@@ -63,6 +63,17 @@ private:
     /*The default max hp of a HealthPoints instance*/
     static const int DEFAULT_MAX_HP = 100;
 
+    /*
+     * C'tor for HealthPoints class, of an already valid state. Unlike operator-= it records no trace event.
+     *
+     * @param maxHP - Max health points, positive.
+     * @param currentHP - Current health points, in [0, maxHP].
+    */
+    HealthPoints(int maxHP, int currentHP);
+
+    friend class AtomicHealthPoints;
+    friend class HealthPointsLoader;
+
     /*
      * handleHealthPointsEdge - checks if the HP is higher of maxHP or lower than 0 and fix accordingly.
      * 
@@ -89,6 +100,15 @@ private:
     */  
     friend bool operator<(const HealthPoints& healthPoints1, const HealthPoints& healthPoints2);
 
+    /*
+    * radixKey - the key Queue's sort and stableSort use to radix sort a queue of HealthPoints.
+    * 
+    * @param healthPoints - The object to get the key of.
+    * @return
+    * Returns the current hp, which orders the objects as operator< does.
+    */  
+    friend int radixKey(const HealthPoints& healthPoints);
+
     /*
     * operator<< - prints the healthPoints object in the format <currentValue>(<maxValue>)
     * 
@@ -0,0 +1,185 @@
+#include "HealthPointsIndex.h"
+
+
+HealthPointsIndex::HealthPointsIndex() : m_nodes(), m_root(NO_NODE), m_randomState(0x9E3779B9u) {}
+
+void HealthPointsIndex::update(int entity, const HealthPoints& healthPoints){
+    if(entity < 0){
+        throw InvalidArgument();
+    }
+    while(m_nodes.size() <= entity){
+        m_nodes.pushBack(Node());
+    }
+    erase(entity);
+
+    Node& node = m_nodes[entity];
+    node.m_healthPoints = healthPoints;
+    node.m_left = NO_NODE;
+    node.m_right = NO_NODE;
+    node.m_size = 1;
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 17;
+    m_randomState ^= m_randomState << 5;
+    node.m_priority = m_randomState;
+    node.m_indexed = true;
+    m_root = insertNode(m_root, entity);
+}
+
+bool HealthPointsIndex::erase(int entity){
+    if(!contains(entity)){
+        return false;
+    }
+    m_root = eraseNode(m_root, entity);
+    m_nodes[entity].m_indexed = false;
+    return true;
+}
+
+bool HealthPointsIndex::contains(int entity) const{
+    return entity >= 0 && entity < m_nodes.size() && m_nodes[entity].m_indexed;
+}
+
+int HealthPointsIndex::size() const{
+    return subtreeSize(m_root);
+}
+
+Queue<int> HealthPointsIndex::topK(int k) const{
+    Queue<int> result;
+    collectFirst(m_root, k, result);
+    return result;
+}
+
+int HealthPointsIndex::countBelow(const HealthPoints& healthPoints) const{
+    int count = 0;
+    int node = m_root;
+    while(node != NO_NODE){
+        if(m_nodes[node].m_healthPoints < healthPoints){
+            count += subtreeSize(m_nodes[node].m_left) + 1;
+            node = m_nodes[node].m_right;
+        }
+        else{
+            node = m_nodes[node].m_left;
+        }
+    }
+    return count;
+}
+
+Queue<int> HealthPointsIndex::rangeQuery(const HealthPoints& low, const HealthPoints& high) const{
+    Queue<int> result;
+    collectRange(m_root, low, high, result);
+    return result;
+}
+
+bool HealthPointsIndex::isBefore(int entity1, int entity2) const{
+    const HealthPoints& healthPoints1 = m_nodes[entity1].m_healthPoints;
+    const HealthPoints& healthPoints2 = m_nodes[entity2].m_healthPoints;
+    if(healthPoints1 != healthPoints2){
+        return healthPoints1 < healthPoints2;
+    }
+    return entity1 < entity2;
+}
+
+int HealthPointsIndex::subtreeSize(int node) const{
+    return node == NO_NODE ? 0 : m_nodes[node].m_size;
+}
+
+void HealthPointsIndex::updateSize(int node){
+    m_nodes[node].m_size = subtreeSize(m_nodes[node].m_left) + subtreeSize(m_nodes[node].m_right) + 1;
+}
+
+int HealthPointsIndex::insertNode(int root, int node){
+    if(root == NO_NODE){
+        return node;
+    }
+    if(m_nodes[node].m_priority > m_nodes[root].m_priority){
+        /* The new node becomes the root of this subtree - split the subtree around it */
+        split(root, node, m_nodes[node].m_left, m_nodes[node].m_right);
+        updateSize(node);
+        return node;
+    }
+    if(isBefore(node, root)){
+        m_nodes[root].m_left = insertNode(m_nodes[root].m_left, node);
+    }
+    else{
+        m_nodes[root].m_right = insertNode(m_nodes[root].m_right, node);
+    }
+    updateSize(root);
+    return root;
+}
+
+int HealthPointsIndex::eraseNode(int root, int node){
+    if(root == node){
+        return merge(m_nodes[root].m_left, m_nodes[root].m_right);
+    }
+    if(isBefore(node, root)){
+        m_nodes[root].m_left = eraseNode(m_nodes[root].m_left, node);
+    }
+    else{
+        m_nodes[root].m_right = eraseNode(m_nodes[root].m_right, node);
+    }
+    updateSize(root);
+    return root;
+}
+
+void HealthPointsIndex::split(int root, int node, int& left, int& right){
+    if(root == NO_NODE){
+        left = NO_NODE;
+        right = NO_NODE;
+        return;
+    }
+    if(isBefore(root, node)){
+        split(m_nodes[root].m_right, node, m_nodes[root].m_right, right);
+        left = root;
+    }
+    else{
+        split(m_nodes[root].m_left, node, left, m_nodes[root].m_left);
+        right = root;
+    }
+    updateSize(root);
+}
+
+int HealthPointsIndex::merge(int left, int right){
+    if(left == NO_NODE){
+        return right;
+    }
+    if(right == NO_NODE){
+        return left;
+    }
+    if(m_nodes[left].m_priority > m_nodes[right].m_priority){
+        m_nodes[left].m_right = merge(m_nodes[left].m_right, right);
+        updateSize(left);
+        return left;
+    }
+    m_nodes[right].m_left = merge(left, m_nodes[right].m_left);
+    updateSize(right);
+    return right;
+}
+
+void HealthPointsIndex::collectFirst(int root, int k, Queue<int>& result) const{
+    if(root == NO_NODE || result.size() >= k){
+        return;
+    }
+    collectFirst(m_nodes[root].m_left, k, result);
+    if(result.size() < k){
+        result.pushBack(root);
+        collectFirst(m_nodes[root].m_right, k, result);
+    }
+}
+
+void HealthPointsIndex::collectRange(int root, const HealthPoints& low, const HealthPoints& high,
+                                     Queue<int>& result) const{
+    if(root == NO_NODE){
+        return;
+    }
+    const HealthPoints& healthPoints = m_nodes[root].m_healthPoints;
+    bool aboveLow = !(healthPoints < low);
+    bool belowHigh = !(high < healthPoints);
+    if(aboveLow){
+        collectRange(m_nodes[root].m_left, low, high, result);
+    }
+    if(aboveLow && belowHigh){
+        result.pushBack(root);
+    }
+    if(belowHigh){
+        collectRange(m_nodes[root].m_right, low, high, result);
+    }
+}
@@ -0,0 +1,161 @@
+#ifndef HEALTH_POINTS_INDEX_H
+#define HEALTH_POINTS_INDEX_H
+
+#include "HealthPoints.h"
+#include "Queue.h"
+
+/*
+ * HealthPointsIndex - Order statistics index over the HealthPoints of entities, ordered by operator<
+ * (entities with equal hp are ordered by id). Kept sorted as hp changes, so the weakest entities
+ * or the entities in an hp range are found without copying and sorting the whole collection.
+ *
+ * The index is a treap whose nodes hold the size of their subtree. Every operation takes O(log n) expected
+ * time, plus the size of the result. Entity ids are small non-negative integers, such as HealthPointsPool ids,
+ * and the nodes are stored in a Queue indexed by id, so the memory is proportional to the largest id.
+*/
+class HealthPointsIndex{
+
+public:
+
+    /*
+     * C'tor for HealthPointsIndex class.
+     *
+     * @return
+     * A new, empty instance of HealthPointsIndex.
+    */
+    HealthPointsIndex();
+
+    /*
+     * update - inserts the entity with the given hp, or moves it to its new place if it is already indexed.
+     *
+     * @param entity - id of the entity, non-negative.
+     * @param healthPoints - the hp of the entity.
+     * @exception
+     * InvalidArgument exception if entity is negative,
+     * std::bad_alloc exception might be thrown.
+    */
+    void update(int entity, const HealthPoints& healthPoints);
+
+    /*
+     * erase - removes the entity from the index.
+     *
+     * @param entity - id of the entity.
+     * @return
+     * Returns true if the entity was removed, false if it was not indexed.
+    */
+    bool erase(int entity);
+
+    /*
+     * contains - checks if the entity is indexed.
+    */
+    bool contains(int entity) const;
+
+    /*
+     * size - the number of indexed entities.
+    */
+    int size() const;
+
+    /*
+     * topK - the k entities with the lowest hp.
+     *
+     * @param k - the number of entities to return.
+     * @return
+     * Returns a Queue of at most k entity ids, from the lowest hp up.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    Queue<int> topK(int k) const;
+
+    /*
+     * countBelow - the number of entities whose hp is lower than the given hp.
+     *
+     * @param healthPoints - the hp to compare with, using operator<.
+     * @return
+     * Returns the number of entities.
+    */
+    int countBelow(const HealthPoints& healthPoints) const;
+
+    /*
+     * rangeQuery - the entities whose hp is between low and high, inclusive.
+     *
+     * @param low - the lowest hp to return.
+     * @param high - the highest hp to return.
+     * @return
+     * Returns a Queue of entity ids, from the lowest hp up.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    Queue<int> rangeQuery(const HealthPoints& low, const HealthPoints& high) const;
+
+    /*
+    * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+private:
+
+    /*
+     * Node - the node of an entity. Children are ids, so growing the Queue of nodes does not invalidate them.
+    */
+    struct Node {
+        HealthPoints m_healthPoints;
+        int m_left = NO_NODE;
+        int m_right = NO_NODE;
+        int m_size = 0;
+        unsigned m_priority = 0;
+        bool m_indexed = false;
+    };
+
+    static const int NO_NODE = -1;
+
+    Queue<Node> m_nodes;
+    int m_root;
+    unsigned m_randomState;
+
+    /*
+     * isBefore - checks if the first entity comes before the second in the index order.
+    */
+    bool isBefore(int entity1, int entity2) const;
+
+    /*
+     * subtreeSize - the size of the subtree, 0 for NO_NODE.
+    */
+    int subtreeSize(int node) const;
+
+    /*
+     * updateSize - recomputes the size of the node from its children.
+    */
+    void updateSize(int node);
+
+    /*
+     * insertNode - inserts the node to the subtree, and returns the new root of the subtree.
+    */
+    int insertNode(int root, int node);
+
+    /*
+     * eraseNode - removes the node from the subtree, and returns the new root of the subtree.
+    */
+    int eraseNode(int root, int node);
+
+    /*
+     * split - splits the subtree to the nodes that come before the given node and the nodes that come after it.
+    */
+    void split(int root, int node, int& left, int& right);
+
+    /*
+     * merge - joins two subtrees, every node of the first coming before every node of the second.
+    */
+    int merge(int left, int right);
+
+    /*
+     * collectFirst - appends the ids of the subtree in order to result, until result holds k ids.
+    */
+    void collectFirst(int root, int k, Queue<int>& result) const;
+
+    /*
+     * collectRange - appends the ids of the subtree whose hp is between low and high to result, in order.
+    */
+    void collectRange(int root, const HealthPoints& low, const HealthPoints& high, Queue<int>& result) const;
+};
+
+#endif //HEALTH_POINTS_INDEX_H
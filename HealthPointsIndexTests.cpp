@@ -0,0 +1,92 @@
+#include "HealthPointsIndex.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace HealthPointsIndexTests {
+
+static HealthPoints makeHealthPoints(int currentHP)
+{
+	HealthPoints healthPoints(1000);
+	healthPoints -= 1000 - currentHP;
+	return healthPoints;
+}
+
+bool testOrderStatistics()
+{
+	bool testResult = true;
+
+	HealthPointsIndex index;
+	index.update(3, makeHealthPoints(50));
+	index.update(0, makeHealthPoints(10));
+	index.update(7, makeHealthPoints(90));
+	index.update(1, makeHealthPoints(50));
+	index.update(2, makeHealthPoints(5));
+	AGREGATE_TEST_RESULT(testResult, index.size() == 5 && index.contains(7) && !index.contains(4));
+
+	Queue<int> weakest = index.topK(3);
+	int expectedWeakest[] = { 2, 0, 1 };
+	int i = 0;
+	for (int entity : weakest) {
+		AGREGATE_TEST_RESULT(testResult, entity == expectedWeakest[i++]);
+	}
+	AGREGATE_TEST_RESULT(testResult, i == 3 && index.topK(100).size() == 5);
+
+	AGREGATE_TEST_RESULT(testResult, index.countBelow(makeHealthPoints(50)) == 2);
+	AGREGATE_TEST_RESULT(testResult, index.countBelow(makeHealthPoints(51)) == 4);
+	Queue<int> range = index.rangeQuery(makeHealthPoints(10), makeHealthPoints(50));
+	AGREGATE_TEST_RESULT(testResult, range.size() == 3 && range.front() == 0);
+
+	index.update(2, makeHealthPoints(100));
+	AGREGATE_TEST_RESULT(testResult, index.topK(1).front() == 0 && index.size() == 5);
+	AGREGATE_TEST_RESULT(testResult, index.erase(0) && !index.erase(0) && index.topK(1).front() == 1);
+
+	bool exceptionThrown = false;
+	try {
+		index.update(-1, makeHealthPoints(1));
+	}
+	catch (HealthPointsIndex::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testAgainstLinearScan()
+{
+	bool testResult = true;
+
+	const int NUMBER_OF_ENTITIES = 300;
+	int currentHP[NUMBER_OF_ENTITIES];
+	HealthPointsIndex index;
+	unsigned state = 7;
+	for (int step = 0; step < 3000; step++) {
+		state = state * 1103515245u + 12345u;
+		int entity = (state >> 8) % NUMBER_OF_ENTITIES;
+		currentHP[entity] = (state >> 20) % 200;
+		index.update(entity, makeHealthPoints(currentHP[entity]));
+		if (step % 100 != 99) {
+			continue;
+		}
+		/* every indexed entity was updated at least once */
+		int threshold = (state >> 4) % 200;
+		int expectedCount = 0;
+		for (int e = 0; e < NUMBER_OF_ENTITIES; e++) {
+			expectedCount += index.contains(e) && currentHP[e] < threshold ? 1 : 0;
+		}
+		AGREGATE_TEST_RESULT(testResult, index.countBelow(makeHealthPoints(threshold)) == expectedCount);
+		Queue<int> ordered = index.topK(index.size());
+		int previousHP = -1;
+		int previousEntity = -1;
+		for (int e : ordered) {
+			AGREGATE_TEST_RESULT(testResult, currentHP[e] > previousHP ||
+				(currentHP[e] == previousHP && e > previousEntity));
+			previousHP = currentHP[e];
+			previousEntity = e;
+		}
+	}
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,211 @@
+#include "HealthPointsLoader.h"
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool isSpace(char character){
+    return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+}
+
+
+HealthPointsLoader::HealthPointsLoader(Queue<HealthPoints>& destination) : m_destination(destination),
+    m_pendingSize(0), m_line(1), m_records(0) {}
+
+void HealthPointsLoader::feed(const char* data, std::size_t size){
+    const char* position = data;
+    const char* end = data + size;
+    if(m_pendingSize > 0){
+        /* The record split from the last chunk continues up to the first whitespace */
+        while(position < end && !isSpace(*position)){
+            if(m_pendingSize == MAX_RECORD_BYTES){
+                throw ParseError(m_line, ParseError::MALFORMED);
+            }
+            m_pending[m_pendingSize++] = *position++;
+        }
+        if(position == end){
+            return;
+        }
+        m_pending[m_pendingSize++] = ' ';
+        parseRecords(m_pending, m_pending + m_pendingSize);
+        m_pendingSize = 0;
+    }
+
+    const char* completeEnd = end;
+    while(completeEnd > position && !isSpace(completeEnd[-1])){
+        completeEnd--;
+    }
+    reserveFor(position, completeEnd);
+    parseRecords(position, completeEnd);
+
+    if(end - completeEnd > MAX_RECORD_BYTES){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+    std::memcpy(m_pending, completeEnd, end - completeEnd);
+    m_pendingSize = static_cast<int>(end - completeEnd);
+}
+
+void HealthPointsLoader::finish(){
+    if(m_pendingSize > 0){
+        m_pending[m_pendingSize++] = ' ';
+        parseRecords(m_pending, m_pending + m_pendingSize);
+        m_pendingSize = 0;
+    }
+}
+
+long long HealthPointsLoader::numberOfRecords() const{
+    return m_records;
+}
+
+long long HealthPointsLoader::loadFile(const std::string& path, Queue<HealthPoints>& destination){
+#ifdef __linux__
+    int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if(fileDescriptor < 0){
+        throw FileError();
+    }
+    /* Closes the file and unmaps it however the load ends */
+    struct File {
+        int m_fileDescriptor;
+        void* m_mapping;
+        std::size_t m_bytes;
+        ~File(){
+            if(m_mapping != nullptr){
+                munmap(m_mapping, m_bytes);
+            }
+            close(m_fileDescriptor);
+        }
+    } file{ fileDescriptor, nullptr, 0 };
+
+    HealthPointsLoader loader(destination);
+    struct stat status;
+    if(fstat(fileDescriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0){
+        file.m_bytes = static_cast<std::size_t>(status.st_size);
+        void* mapping = mmap(nullptr, file.m_bytes, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if(mapping != MAP_FAILED){
+            file.m_mapping = mapping;
+            madvise(mapping, file.m_bytes, MADV_SEQUENTIAL);
+            loader.feed(static_cast<const char*>(mapping), file.m_bytes);
+            loader.finish();
+            return loader.numberOfRecords();
+        }
+    }
+
+    std::unique_ptr<char[]> chunk(new char[CHUNK_BYTES]);
+    while(true){
+        ssize_t bytesRead = read(fileDescriptor, chunk.get(), CHUNK_BYTES);
+        if(bytesRead < 0){
+            throw FileError();
+        }
+        if(bytesRead == 0){
+            break;
+        }
+        loader.feed(chunk.get(), static_cast<std::size_t>(bytesRead));
+    }
+    loader.finish();
+    return loader.numberOfRecords();
+#else
+    std::ifstream stream(path, std::ios::binary);
+    if(!stream){
+        throw FileError();
+    }
+    return loadStream(stream, destination);
+#endif
+}
+
+long long HealthPointsLoader::loadStream(std::istream& stream, Queue<HealthPoints>& destination){
+    HealthPointsLoader loader(destination);
+    std::unique_ptr<char[]> chunk(new char[CHUNK_BYTES]);
+    while(stream){
+        stream.read(chunk.get(), CHUNK_BYTES);
+        loader.feed(chunk.get(), static_cast<std::size_t>(stream.gcount()));
+    }
+    loader.finish();
+    return loader.numberOfRecords();
+}
+
+void HealthPointsLoader::parseRecords(const char* begin, const char* end){
+    const char* position = begin;
+    while(true){
+        while(position < end && isSpace(*position)){
+            if(*position == '\n'){
+                m_line++;
+            }
+            position++;
+        }
+        if(position == end){
+            return;
+        }
+        parseRecord(position);
+    }
+}
+
+void HealthPointsLoader::parseRecord(const char*& position){
+    int currentHP = parseNumber(position);
+    if(*position != '('){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+    position++;
+    int maxHP = parseNumber(position);
+    if(*position != ')'){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+    position++;
+    if(!isSpace(*position)){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+
+    if(maxHP <= 0){
+        throw ParseError(m_line, ParseError::INVALID_MAX_HP);
+    }
+    if(currentHP < 0 || currentHP > maxHP){
+        throw ParseError(m_line, ParseError::INVALID_CURRENT_HP);
+    }
+    m_destination.pushBack(HealthPoints(maxHP, currentHP));
+    m_records++;
+}
+
+int HealthPointsLoader::parseNumber(const char*& position) const{
+    bool negative = *position == '-';
+    if(negative){
+        position++;
+    }
+    const char* digitsBegin = position;
+    long long value = 0;
+    while(static_cast<unsigned char>(*position - '0') < 10 && position - digitsBegin < 10){
+        value = value * 10 + (*position - '0');
+        position++;
+    }
+    if(position == digitsBegin || static_cast<unsigned char>(*position - '0') < 10){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+    value = negative ? -value : value;
+    if(value < INT_MIN || value > INT_MAX){
+        throw ParseError(m_line, ParseError::MALFORMED);
+    }
+    return static_cast<int>(value);
+}
+
+void HealthPointsLoader::reserveFor(const char* begin, const char* end){
+    long long records = 0;
+    for(const char* position = begin ; ; position++){
+        position = static_cast<const char*>(std::memchr(position, '(', end - position));
+        if(position == nullptr){
+            break;
+        }
+        records++;
+    }
+    long long capacity = m_destination.size() + records;
+    m_destination.reserve(capacity < INT_MAX ? static_cast<int>(capacity) : INT_MAX);
+}
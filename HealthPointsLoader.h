@@ -0,0 +1,161 @@
+#ifndef HEALTH_POINTS_LOADER_H
+#define HEALTH_POINTS_LOADER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "HealthPoints.h"
+#include "Queue.h"
+
+/*
+ * HealthPointsLoader - Parses HealthPoints records in the current(max) format printed by operator<<, and
+ * pushes them to the end of a Queue<HealthPoints>.
+ * Records are separated by whitespace, so a dump with one record per line and a dump of records separated
+ * by spaces are both read. The input is fed in chunks of any size - a record may be split between two
+ * chunks - and before parsing a chunk the queue is reserved for the records it holds, found by scanning
+ * for '(' with memchr.
+ *
+ * A record is valid if it could have been printed by a HealthPoints: max is positive, as the constructor
+ * requires, and current is between 0 and max. The first record that is not valid stops the parse with a
+ * ParseError holding its line number, and the records before it stay in the queue.
+*/
+class HealthPointsLoader{
+
+public:
+
+    /* The size of the chunks loadFile and loadStream read */
+    static const std::size_t CHUNK_BYTES = 1 << 20;
+
+    /*
+     * ParseError - Exception for a record that cannot be parsed or is not valid.
+    */
+    class ParseError {
+
+    public:
+
+        /* What is wrong with the record */
+        enum Reason { MALFORMED, INVALID_MAX_HP, INVALID_CURRENT_HP };
+
+        ParseError(long long line, Reason reason) : m_line(line), m_reason(reason) {}
+
+        /* The line of the record, starting from 1 */
+        long long line() const { return m_line; }
+
+        Reason reason() const { return m_reason; }
+
+    private:
+
+        long long m_line;
+        Reason m_reason;
+    };
+
+    /*
+     * FileError - Exception for a file that cannot be opened or read.
+    */
+    class FileError {};
+
+    /*
+     * C'tor for HealthPointsLoader class.
+     *
+     * @param destination - the queue the records are pushed to.
+     * @return
+     * A new instance of HealthPointsLoader, at line 1.
+    */
+    explicit HealthPointsLoader(Queue<HealthPoints>& destination);
+
+    /*
+     * The loader keeps a reference to its queue and the unparsed end of the last chunk, so copying is not allowed.
+    */
+    HealthPointsLoader(const HealthPointsLoader& loader) = delete;
+    HealthPointsLoader& operator=(const HealthPointsLoader& otherLoader) = delete;
+
+    /*
+     * feed - Parses the records of the next chunk of the input.
+     * The end of the chunk is kept for the next call if it may be the beginning of a record split between chunks.
+     *
+     * @param data - the chunk.
+     * @param size - the number of bytes of the chunk.
+     * @exception
+     * ParseError exception if a record is not valid,
+     * std::bad_alloc exception might be thrown.
+    */
+    void feed(const char* data, std::size_t size);
+
+    /*
+     * finish - Parses the record kept from the last chunk, at the end of the input.
+     *
+     * @exception
+     * ParseError exception if the record is not valid,
+     * std::bad_alloc exception might be thrown.
+    */
+    void finish();
+
+    /*
+     * numberOfRecords - the number of records pushed to the queue so far.
+    */
+    long long numberOfRecords() const;
+
+    /*
+     * loadFile - Loads all the records of a file. A regular file is mapped to memory, other files, such as
+     * pipes, are read in chunks of CHUNK_BYTES.
+     *
+     * @param path - the path of the file.
+     * @param destination - the queue the records are pushed to.
+     * @return
+     * Returns the number of records loaded.
+     * @exception
+     * FileError exception if the file cannot be opened or read,
+     * ParseError exception if a record is not valid,
+     * std::bad_alloc exception might be thrown.
+    */
+    static long long loadFile(const std::string& path, Queue<HealthPoints>& destination);
+
+    /*
+     * loadStream - Loads all the records of a stream, read in chunks of CHUNK_BYTES.
+     *
+     * @param stream - the stream to read until its end.
+     * @param destination - the queue the records are pushed to.
+     * @return
+     * Returns the number of records loaded.
+     * @exception
+     * ParseError exception if a record is not valid,
+     * std::bad_alloc exception might be thrown.
+    */
+    static long long loadStream(std::istream& stream, Queue<HealthPoints>& destination);
+
+private:
+
+    /* The longest record, "-2147483648(-2147483648)", longer text cannot be a record */
+    static const int MAX_RECORD_BYTES = 24;
+
+    Queue<HealthPoints>& m_destination;
+    /* The end of the last chunk, with room for the whitespace parseRecords needs after it */
+    char m_pending[MAX_RECORD_BYTES + 1];
+    int m_pendingSize;
+    long long m_line;
+    long long m_records;
+
+    /*
+     * parseRecords - parses the whitespace separated records of a part of the input that is empty or ends
+     * with whitespace. The whitespace stops every scan inside a record, so the scans need no bounds checks.
+    */
+    void parseRecords(const char* begin, const char* end);
+
+    /*
+     * parseRecord - parses the record that starts at position, and moves position past it.
+    */
+    void parseRecord(const char*& position);
+
+    /*
+     * parseNumber - parses an optionally negative int at position, and moves position past it.
+    */
+    int parseNumber(const char*& position) const;
+
+    /*
+     * reserveFor - reserves the queue for the records that start in a part of the input.
+    */
+    void reserveFor(const char* begin, const char* end);
+};
+
+#endif //HEALTH_POINTS_LOADER_H
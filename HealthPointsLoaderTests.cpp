@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "HealthPointsLoader.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace HealthPointsLoaderTests {
+
+static std::string printed(const Queue<HealthPoints>& queue)
+{
+	std::ostringstream stream;
+	for (const HealthPoints& healthPoints : queue) {
+		stream << healthPoints << '\n';
+	}
+	return stream.str();
+}
+
+/* Returns the line and reason of the ParseError the text causes, or line 0 if it loads */
+static HealthPointsLoader::ParseError parseError(const std::string& text)
+{
+	Queue<HealthPoints> queue;
+	std::istringstream stream(text);
+	try {
+		HealthPointsLoader::loadStream(stream, queue);
+	}
+	catch (HealthPointsLoader::ParseError& e) {
+		return e;
+	}
+	return HealthPointsLoader::ParseError(0, HealthPointsLoader::ParseError::MALFORMED);
+}
+
+bool testParse()
+{
+	bool testResult = true;
+
+	Queue<HealthPoints> original;
+	for (int i = 1; i <= 300; i++) {
+		HealthPoints healthPoints(i * 37);
+		healthPoints -= (i * 101) % (i * 37 + 1);
+		original.pushBack(healthPoints);
+	}
+	std::string text = printed(original);
+
+	std::istringstream stream(text);
+	Queue<HealthPoints> loaded;
+	AGREGATE_TEST_RESULT(testResult, HealthPointsLoader::loadStream(stream, loaded) == 300);
+	AGREGATE_TEST_RESULT(testResult, printed(loaded) == text);
+
+	/* every record split between chunks, at every place */
+	Queue<HealthPoints> fedByteByByte;
+	HealthPointsLoader loader(fedByteByByte);
+	for (char character : text) {
+		loader.feed(&character, 1);
+	}
+	loader.finish();
+	AGREGATE_TEST_RESULT(testResult, loader.numberOfRecords() == 300 && printed(fedByteByByte) == text);
+
+	Queue<HealthPoints> spaced;
+	std::istringstream spacedStream("  5(10) 0(1)\t\r\n2147483647(2147483647)");
+	AGREGATE_TEST_RESULT(testResult, HealthPointsLoader::loadStream(spacedStream, spaced) == 3);
+	AGREGATE_TEST_RESULT(testResult, printed(spaced) == "5(10)\n0(1)\n2147483647(2147483647)\n");
+
+	const char* path = "HealthPointsLoaderTests.tmp";
+	std::ofstream file(path, std::ios::binary);
+	file << text;
+	file.close();
+	Queue<HealthPoints> fromFile;
+	fromFile.pushBack(HealthPoints(1));
+	AGREGATE_TEST_RESULT(testResult, HealthPointsLoader::loadFile(path, fromFile) == 300 && fromFile.size() == 301);
+	fromFile.popFront();
+	AGREGATE_TEST_RESULT(testResult, printed(fromFile) == text);
+	std::remove(path);
+
+	bool exceptionThrown = false;
+	try {
+		HealthPointsLoader::loadFile(path, fromFile);
+	}
+	catch (HealthPointsLoader::FileError& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testErrors()
+{
+	bool testResult = true;
+
+	HealthPointsLoader::ParseError error = parseError("1(1)\n2(2)\n\n3(0)\n");
+	AGREGATE_TEST_RESULT(testResult, error.line() == 4 && error.reason() == HealthPointsLoader::ParseError::INVALID_MAX_HP);
+	error = parseError("1(1)\n5(-3)");
+	AGREGATE_TEST_RESULT(testResult, error.line() == 2 && error.reason() == HealthPointsLoader::ParseError::INVALID_MAX_HP);
+	error = parseError("11(10)");
+	AGREGATE_TEST_RESULT(testResult, error.line() == 1 && error.reason() == HealthPointsLoader::ParseError::INVALID_CURRENT_HP);
+	error = parseError("1(1)\n-1(10)");
+	AGREGATE_TEST_RESULT(testResult, error.line() == 2 && error.reason() == HealthPointsLoader::ParseError::INVALID_CURRENT_HP);
+
+	const char* malformed[] = { "1(1", "1 (1)", "(1)", "1(1)x", "1(2147483648)", "1(12345678901)", "abc", "1(1)(2)" };
+	for (const char* text : malformed) {
+		error = parseError(std::string("2(2)\n") + text + "\n");
+		AGREGATE_TEST_RESULT(testResult, error.line() == 2 && error.reason() == HealthPointsLoader::ParseError::MALFORMED);
+	}
+
+	/* the records before the error stay in the queue */
+	Queue<HealthPoints> queue;
+	std::istringstream stream("3(4) 4(4) 9(x)");
+	try {
+		HealthPointsLoader::loadStream(stream, queue);
+	}
+	catch (HealthPointsLoader::ParseError& e) {
+	}
+	AGREGATE_TEST_RESULT(testResult, printed(queue) == "3(4)\n4(4)\n");
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,92 @@
+#include "HealthPointsPool.h"
+
+
+int HealthPointsPool::add(int maxHP){
+    if(maxHP <= 0){
+        throw InvalidArgument();
+    }
+    m_entities.pushBack(Entity{ maxHP, maxHP, NOT_WATCHED });
+    return m_entities.size() - 1;
+}
+
+void HealthPointsPool::watch(int entity, int kinds, int thresholdPercent){
+    checkEntity(entity);
+    if((kinds & ON_THRESHOLD) && (thresholdPercent <= 0 || thresholdPercent >= 100)){
+        throw InvalidArgument();
+    }
+    Entity& data = m_entities[entity];
+    Watch watch = { kinds, static_cast<int>(static_cast<long long>(data.m_maxHP) * thresholdPercent / 100) };
+    if(data.m_watchIndex == NOT_WATCHED){
+        m_watches.pushBack(watch);
+        data.m_watchIndex = m_watches.size() - 1;
+    }
+    else{
+        m_watches[data.m_watchIndex] = watch;
+    }
+}
+
+void HealthPointsPool::heal(int entity, int hpToAdd){
+    change(entity, hpToAdd);
+}
+
+void HealthPointsPool::damage(int entity, int hpToDecrease){
+    change(entity, -static_cast<long long>(hpToDecrease));
+}
+
+int HealthPointsPool::getCurrentHP(int entity) const{
+    checkEntity(entity);
+    return m_entities[entity].m_currentHP;
+}
+
+int HealthPointsPool::getMaxHP(int entity) const{
+    checkEntity(entity);
+    return m_entities[entity].m_maxHP;
+}
+
+int HealthPointsPool::size() const{
+    return m_entities.size();
+}
+
+bool HealthPointsPool::popEventInto(Event& destination){
+    return m_events.popFrontInto(destination);
+}
+
+int HealthPointsPool::numberOfEvents() const{
+    return m_events.size();
+}
+
+void HealthPointsPool::change(int entity, long long delta){
+    checkEntity(entity);
+    Entity& data = m_entities[entity];
+    int previousHP = data.m_currentHP;
+    long long currentHP = previousHP + delta;
+    if(currentHP > data.m_maxHP){
+        currentHP = data.m_maxHP;
+    }
+    if(currentHP < 0){
+        currentHP = 0;
+    }
+    data.m_currentHP = static_cast<int>(currentHP);
+
+    if(data.m_watchIndex != NOT_WATCHED && data.m_currentHP != previousHP){
+        emitEvents(entity, m_watches[data.m_watchIndex], previousHP, data.m_currentHP);
+    }
+}
+
+void HealthPointsPool::emitEvents(int entity, const Watch& watch, int previousHP, int currentHP){
+    if((watch.m_kinds & ON_THRESHOLD) && (previousHP > watch.m_threshold) != (currentHP > watch.m_threshold)){
+        m_events.pushBack(Event{ entity, ON_THRESHOLD, currentHP <= watch.m_threshold });
+    }
+    if((watch.m_kinds & ON_DEATH) && currentHP == 0){
+        m_events.pushBack(Event{ entity, ON_DEATH, true });
+    }
+    if((watch.m_kinds & ON_FULL_HEAL) && currentHP == m_entities[entity].m_maxHP){
+        m_events.pushBack(Event{ entity, ON_FULL_HEAL, false });
+    }
+}
+
+void HealthPointsPool::checkEntity(int entity) const{
+    if(entity < 0 || entity >= m_entities.size()){
+        throw InvalidArgument();
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef HEALTH_POINTS_POOL_H
+#define HEALTH_POINTS_POOL_H
+
+#include "Queue.h"
+
+/*
+ * HealthPointsPool - The health points of many entities, kept in arrays indexed by entity id.
+ * An entity may be watched for transitions - death, full heal, or crossing a percentage of its max hp -
+ * in which case heal and damage append an Event to the pool's event queue, so the game loop handles
+ * only the entities that changed instead of scanning all of them.
+ * An entity that is not watched costs a single check per operation.
+*/
+class HealthPointsPool{
+
+public:
+
+    /*
+     * Kinds of transitions an entity can be watched for, combined with |.
+    */
+    static const int ON_DEATH = 1;
+    static const int ON_FULL_HEAL = 2;
+    static const int ON_THRESHOLD = 4;
+
+    /*
+     * Event - a transition of a watched entity.
+     * m_kind is one of ON_DEATH, ON_FULL_HEAL or ON_THRESHOLD. For ON_THRESHOLD, m_fell tells
+     * whether the hp fell below the threshold or rose above it.
+    */
+    struct Event {
+        int m_entity;
+        int m_kind;
+        bool m_fell;
+    };
+
+    /*
+     * C'tor for HealthPointsPool class.
+     *
+     * @return
+     * A new, empty instance of HealthPointsPool.
+    */
+    HealthPointsPool() = default;
+
+    /*
+     * add - adds an entity with full health points.
+     *
+     * @param maxHP - Max health points.
+     * @return
+     * Returns the id of the new entity.
+     * @exception
+     * InvalidArgument exception if maxHP is not positive,
+     * std::bad_alloc exception might be thrown.
+    */
+    int add(int maxHP);
+
+    /*
+     * watch - sets the transitions the entity emits events for, replacing earlier settings.
+     *
+     * @param entity - id of the entity.
+     * @param kinds - ON_DEATH, ON_FULL_HEAL and ON_THRESHOLD combined with |, or 0 to stop watching.
+     * @param thresholdPercent - for ON_THRESHOLD, the percentage of the max hp to watch, between 1 and 99.
+     * @exception
+     * InvalidArgument exception if the entity does not exist or thresholdPercent is out of range,
+     * std::bad_alloc exception might be thrown.
+    */
+    void watch(int entity, int kinds, int thresholdPercent = 0);
+
+    /*
+     * heal - adds hp to the entity, up to its max hp.
+     *
+     * @param entity - id of the entity.
+     * @param hpToAdd - The amount of hp to add.
+     * @exception
+     * InvalidArgument exception if the entity does not exist,
+     * std::bad_alloc exception might be thrown when an event is emitted.
+    */
+    void heal(int entity, int hpToAdd);
+
+    /*
+     * damage - decreases the hp of the entity, down to 0.
+     *
+     * @param entity - id of the entity.
+     * @param hpToDecrease - The amount of hp to decrease.
+     * @exception
+     * InvalidArgument exception if the entity does not exist,
+     * std::bad_alloc exception might be thrown when an event is emitted.
+    */
+    void damage(int entity, int hpToDecrease);
+
+    /*
+     * getCurrentHP - the current hp of the entity.
+     *
+     * @exception
+     * InvalidArgument exception if the entity does not exist.
+    */
+    int getCurrentHP(int entity) const;
+
+    /*
+     * getMaxHP - the max hp of the entity.
+     *
+     * @exception
+     * InvalidArgument exception if the entity does not exist.
+    */
+    int getMaxHP(int entity) const;
+
+    /*
+     * size - the number of entities in the pool.
+    */
+    int size() const;
+
+    /*
+     * popEventInto - Moves the oldest event into destination and removes it.
+     *
+     * @param destination - receives the event.
+     * @return
+     * Returns true if an event was removed, false if there are no events.
+    */
+    bool popEventInto(Event& destination);
+
+    /*
+     * numberOfEvents - the number of events that were not popped yet.
+    */
+    int numberOfEvents() const;
+
+    /*
+    * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+private:
+
+    /*
+     * Watch - the transitions a watched entity emits events for.
+    */
+    struct Watch {
+        int m_kinds;
+        int m_threshold;
+    };
+
+    /*
+     * Entity - the hp of an entity, and the index of its Watch or NOT_WATCHED.
+    */
+    struct Entity {
+        int m_currentHP;
+        int m_maxHP;
+        int m_watchIndex;
+    };
+
+    static const int NOT_WATCHED = -1;
+
+    Queue<Entity> m_entities;
+    Queue<Watch> m_watches;
+    Queue<Event> m_events;
+
+    /*
+     * change - adds delta to the hp of the entity, clamped to [0, maxHP], and emits its events.
+    */
+    void change(int entity, long long delta);
+
+    /*
+     * emitEvents - appends the events of a watched entity whose hp changed from previousHP.
+    */
+    void emitEvents(int entity, const Watch& watch, int previousHP, int currentHP);
+
+    /*
+     * checkEntity - throws InvalidArgument if the entity does not exist.
+    */
+    void checkEntity(int entity) const;
+};
+
+#endif //HEALTH_POINTS_POOL_H
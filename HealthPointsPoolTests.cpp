@@ -0,0 +1,70 @@
+#include "HealthPointsPool.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace HealthPointsPoolTests {
+
+static bool checkEvent(HealthPointsPool& pool, int entity, int kind, bool fell)
+{
+	HealthPointsPool::Event event;
+	return pool.popEventInto(event) && event.m_entity == entity && event.m_kind == kind && event.m_fell == fell;
+}
+
+bool testTransitionEvents()
+{
+	bool testResult = true;
+
+	HealthPointsPool pool;
+	int unwatched = pool.add(100);
+	int hero = pool.add(200);
+	int minion = pool.add(10);
+	pool.watch(hero, HealthPointsPool::ON_DEATH | HealthPointsPool::ON_FULL_HEAL | HealthPointsPool::ON_THRESHOLD, 25);
+	pool.watch(minion, HealthPointsPool::ON_DEATH);
+
+	pool.damage(unwatched, 1000);
+	pool.heal(unwatched, 1000);
+	AGREGATE_TEST_RESULT(testResult, pool.getCurrentHP(unwatched) == 100 && pool.numberOfEvents() == 0);
+
+	pool.damage(hero, 100);
+	pool.heal(hero, 10000);
+	AGREGATE_TEST_RESULT(testResult, pool.getCurrentHP(hero) == 200 && checkEvent(pool, hero, HealthPointsPool::ON_FULL_HEAL, false));
+	pool.heal(hero, 5);
+	AGREGATE_TEST_RESULT(testResult, pool.numberOfEvents() == 0);
+
+	pool.damage(hero, 150);
+	AGREGATE_TEST_RESULT(testResult, checkEvent(pool, hero, HealthPointsPool::ON_THRESHOLD, true));
+	pool.damage(minion, 4);
+	pool.damage(hero, 60);
+	pool.damage(minion, 6);
+	AGREGATE_TEST_RESULT(testResult, checkEvent(pool, hero, HealthPointsPool::ON_DEATH, true));
+	AGREGATE_TEST_RESULT(testResult, checkEvent(pool, minion, HealthPointsPool::ON_DEATH, true));
+	pool.damage(minion, 6);
+	AGREGATE_TEST_RESULT(testResult, pool.numberOfEvents() == 0);
+
+	pool.heal(hero, 51);
+	AGREGATE_TEST_RESULT(testResult, checkEvent(pool, hero, HealthPointsPool::ON_THRESHOLD, false));
+	pool.watch(hero, 0);
+	pool.damage(hero, 51);
+	AGREGATE_TEST_RESULT(testResult, pool.numberOfEvents() == 0 && pool.getMaxHP(hero) == 200);
+
+	bool exceptionThrown = false;
+	try {
+		pool.watch(hero, HealthPointsPool::ON_THRESHOLD, 100);
+	}
+	catch (HealthPointsPool::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+	exceptionThrown = false;
+	try {
+		pool.damage(pool.size(), 1);
+	}
+	catch (HealthPointsPool::InvalidArgument& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+}
@@ -4,7 +4,23 @@
 #define QUEUE_H
 
 #include <new>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "QueueBufferCache.h"
+#include "QueueTrace.h"
+
+/* How many elements ahead filter and transform prefetch elements of a cache line or more, 0 disables prefetching */
+#ifndef QUEUE_PREFETCH_DISTANCE
+#define QUEUE_PREFETCH_DISTANCE 8
+#endif
 
 
 template <class T>
@@ -82,15 +98,49 @@ public:
 
     /*
      * popFront - Removes the first element in the queue.
-     * 
+     * The array is compressed once most of it is unused, which never throws (see compress).
      * 
      * @exception
-     * EmptyQueue exception, in case the Queue is empty
-     * or std::bad_alloc exception might be thorwn,
-     * as well as, a random exception might be thrown.
+     * EmptyQueue exception, in case the Queue is empty.
     */
     void popFront();
 
+    /*
+     * tryFront - copy of the first element in the queue, without throwing on an empty queue.
+     *
+     * @return
+     * Returns a copy of the first element, or an empty optional if the Queue is empty.
+    */
+    std::optional<T> tryFront() const noexcept(std::is_nothrow_copy_constructible<T>::value);
+
+    /*
+     * tryPopFront - Removes the first element in the queue and returns it, without throwing on an empty queue.
+     *
+     * @return
+     * Returns the removed element, or an empty optional if the Queue is empty.
+    */
+    std::optional<T> tryPopFront() noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /*
+     * popFrontInto - Moves the first element in the queue into destination and removes it.
+     *
+     * @param destination - receives the first element.
+     * @return
+     * Returns true if an element was removed, false if the Queue is empty (destination is left untouched).
+    */
+    bool popFrontInto(T& destination) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+    /*
+     * popAndGet - Removes the first element in the queue and returns it, moving it out instead of copying.
+     *
+     * @return
+     * Returns the removed element.
+     * @exception
+     * EmptyQueue exception, in case the Queue is empty,
+     * as well as, a random exception might be thrown by the move of T.
+    */
+    T popAndGet();
+
     /*
      * size - the number of elements in Queue.
      * 
@@ -145,16 +195,137 @@ public:
     */
     ConstIterator end() const;
 
+    /*
+     * operator[] - element at the given place in the queue, without bounds checking.
+     *
+     * @param index - place of the element in the queue, 0 for the first element.
+     * @return
+     * Returns the element at the given place.
+    */
+    T& operator[](int index);
+    const T& operator[](int index) const;
+
+    /*
+     * at - element at the given place in the queue.
+     *
+     * @param index - place of the element in the queue, 0 for the first element.
+     * @return
+     * Returns the element at the given place.
+     * @exception
+     * Throws OutOfRange exception if index is negative or not smaller than size().
+    */
+    T& at(int index);
+    const T& at(int index) const;
+
+    /*
+     * find - first element in the queue that is equal to value.
+     *
+     * @param value - the value to look for, compared with operator==.
+     * @return
+     * Returns an Iterator to the element, or end() if there is no such element.
+    */
+    Iterator find(const T& value);
+    ConstIterator find(const T& value) const;
+
+    /*
+     * contains - checks if an element in the queue is equal to value.
+     *
+     * @param value - the value to look for, compared with operator==.
+     * @return
+     * Returns true if such an element exists, else false.
+    */
+    bool contains(const T& value) const;
+
+    /*
+     * eraseIf - Removes every element that satisfies the condition, keeping the order of the rest.
+     * Done in place in a single pass, without allocating - the array keeps its size, and the removed elements
+     * are released with a default constructed T.
+     *
+     * @param condition - The condition used to choose the elements to remove.
+     * @return
+     * Returns the number of removed elements.
+     * @exception
+     * A random exception might be thrown by condition or by the move of T,
+     * in which case some elements may already be removed.
+    */
+    template <class Condition>
+    int eraseIf(const Condition& condition);
+
+    /*
+     * reserve - grows the array in one step so that it holds at least capacity elements.
+     *
+     * @param capacity - the number of elements to make room for.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown, in which case the queue is unchanged.
+    */
+    void reserve(int capacity);
+
+    /*
+     * splice - Moves all the elements of other to the end of the queue, leaving other empty.
+     * If the queue is empty the arrays are swapped, O(1). Otherwise the elements of the shorter of the two
+     * queues are moved, into the array of the other one if it has room for them: O(min(size(), other.size()))
+     * moves, and O(other.size()) moves and a single growth of the array when there is no room.
+     *
+     * @param other - the queue whose elements are appended.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case both queues are unchanged,
+     * as well as, a random exception might be thrown by the move of T, in which case every element is in
+     * one of the two queues, in order, with the elements of the queue before those of other.
+    */
+    void splice(Queue& other);
+
+    /*
+     * splitAt - Removes the elements from the given place to the end, and returns them as a new queue.
+     * The shorter of the two parts is moved to a new array, O(min(index, size() - index)) moves, and the
+     * longer part keeps the current array.
+     *
+     * @param index - place of the first element to remove, 0 to remove all and size() to remove none.
+     * @return
+     * Returns a queue of the removed elements, in order.
+     * @exception
+     * Throws OutOfRange exception if index is negative or larger than size(),
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the copy of T, in which case the queue is unchanged.
+    */
+    Queue splitAt(int index);
+
+    /*
+     * swap - Exchanges the elements of the queue and of other, O(1), without copying or allocating.
+     *
+     * @param other - the queue to exchange elements with.
+    */
+    void swap(Queue& other) noexcept;
+
     /*
      * EmptyQueue - Exception for invalid operations on empty queue
     */
     class EmptyQueue {};
+
+    /*
+     * OutOfRange - Exception for access to a place that is not in the queue
+    */
+    class OutOfRange {};
+
+    /* The size of a cache line, the array of Queue is aligned to it */
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    /* How many elements ahead filter and transform prefetch */
+    static const int PREFETCH_DISTANCE = QUEUE_PREFETCH_DISTANCE;
+
+    /*
+     * Whether T is relocated with memcpy/memmove instead of element by element. For such T the array is not
+     * constructed or destroyed element by element, and it grows with QueueBufferCache::reallocate and memcpy.
+    */
+    static const bool TRIVIAL_DATA = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value;
     
 
 private:
+    /* The elements are kept in a circular array, starting at m_firstIndex */
     T* m_data;
     int m_dataSize;
-    int m_currentIndex;
+    int m_firstIndex;
+    int m_size;
 
     /* The factor by which to expand the array when needed */
     static const int EXPAND_RATE = 2;
@@ -164,6 +335,12 @@ private:
 
     /* first index of array */
     static const int FIRST_INDEX = 0;
+
+    /* The alignment of the array - a cache line, unless T needs more */
+    static const std::size_t DATA_ALIGNMENT = alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE;
+
+    /* Arrays are taken from and given back to the thread's QueueBufferCache, unless T needs more alignment */
+    static const bool USES_BUFFER_CACHE = DATA_ALIGNMENT == QueueBufferCache::ALIGNMENT;
    
     
     /*
@@ -175,16 +352,61 @@ private:
     void expand();
 
     /*
-     * compress - compress the array to the current size of data.
+     * grownDataSize - the size of an array for at least capacity elements: the current size multiplied by
+     * EXPAND_RATE until it is enough, or capacity itself once that would not fit in an int.
+     *
+     * @param capacity - the number of elements, larger than the current size of the array.
+    */
+    int grownDataSize(int capacity) const noexcept;
+
+    /*
+     * growTo - moves the elements to the beginning of a larger array.
+     *
+     * @param newDataSize - the size of the new array, larger than the current one.
      * @exception
      * std::bad_alloc exception might be thorwn,
-     * as well as, a random exception might be thrown.
+     * as well as, a random exception might be thrown, in which case the queue is unchanged.
     */
-    void compress();
+    void growTo(int newDataSize);
 
+    /*
+     * swapData - exchanges the arrays and elements of two queues.
+    */
+    void swapData(Queue& other) noexcept;
 
     /*
-     * copyData - copy data from source queue into destination data
+     * compress - shrinks the array by EXPAND_RATE factor once at most 1/EXPAND_RATE^2 of it is used.
+     * Shrinking is an optimization only, so if allocating or copying fails the array is kept as is.
+    */
+    void compress() noexcept;
+
+    /*
+     * removeFront - removes the first element of a non empty queue, and releases it with releaseElements.
+    */
+    void removeFront() noexcept;
+
+    /*
+     * releaseElements - assigns a default constructed T to the elements at the given places, so that elements
+     * being removed release what they hold. Nothing is done for TRIVIAL_DATA. If an assignment throws,
+     * the elements not assigned yet are kept until their places are reused.
+     *
+     * @param first - place in the queue of the first element.
+     * @param last - place in the queue after the last element.
+    */
+    void releaseElements(int first, int last) noexcept;
+
+    /*
+     * physicalIndex - position in the array of the element at the given place in the queue.
+     *
+     * @param index - place of the element in the queue, 0 for the first element.
+     * @return
+     * Returns the index in m_data of the element.
+    */
+    int physicalIndex(int index) const noexcept;
+
+
+    /*
+     * copyData - copy the elements of source queue, in order, to the beginning of destination data
      * 
      * @param destinationData - destination to paste the data from source queue.
      * @param destinationDataSize - size of the destination data.
@@ -202,6 +424,168 @@ private:
     */
     void updateData(T* newData);
 
+    /*
+     * allocateData - allocates a cache line aligned array of default constructed elements.
+     *
+     * @param size - the number of elements.
+     * @return
+     * Returns the new array.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown.
+    */
+    static T* allocateData(int size);
+
+    /*
+     * deallocateData - destroys the elements of an array from allocateData and frees it.
+     *
+     * @param data - the array, may be nullptr.
+     * @param size - the number of elements of the array.
+    */
+    static void deallocateData(T* data, int size);
+
+    /*
+     * allocateBlock - allocates uninitialized memory for an array of the given number of elements.
+     *
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    static void* allocateBlock(int size);
+
+    /*
+     * freeBlock - frees the memory of an array from allocateBlock or reallocateData.
+    */
+    static void freeBlock(void* block, int size) noexcept;
+
+    /*
+     * reallocateData - grows the array of a TRIVIAL_DATA queue that USES_BUFFER_CACHE, in place when the new size
+     * is in the size class of the array, keeping the elements in order.
+     *
+     * @param newDataSize - the new number of elements of the array.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is unchanged.
+    */
+    void reallocateData(int newDataSize);
+
+    /*
+     * dataBytes - size in bytes of an array of the given number of elements, rounded up to DATA_ALIGNMENT.
+    */
+    static std::size_t dataBytes(int size);
+
+    /*
+     * forEach - calls function on every element in order, prefetching PREFETCH_DISTANCE elements ahead.
+     * Used by filter and transform.
+    */
+    template <class Function>
+    void forEach(const Function& function);
+
+    template <class Function>
+    void forEach(const Function& function) const;
+
+    /*
+     * scanSegment - calls function on every element of a contiguous part of the array, with prefetching.
+    */
+    template <class Element, class Function>
+    static void scanSegment(Element* begin, Element* end, const Function& function);
+
+    /*
+     * forEachSegment - calls function(begin, end) on each of the, at most two, contiguous parts of the array
+     * that hold the elements, in order. Used by the reductions, whose loops over a plain array vectorize.
+    */
+    template <class Function>
+    void forEachSegment(const Function& function) const;
+
+    /* Number of independent accumulators of the reduction kernels, enough to fill a vector register */
+    static const int REDUCTION_LANES = 8;
+
+    /*
+     * sumSegment - sum of a contiguous part of the array, accumulated in REDUCTION_LANES partial sums.
+    */
+    static T sumSegment(const T* begin, const T* end);
+
+    /*
+     * extremeOfSegment - the smallest, or the largest if MAXIMUM, value of a non empty contiguous part of the array.
+    */
+    template <bool MAXIMUM>
+    static T extremeOfSegment(const T* begin, const T* end);
+
+    /*
+     * extremeElement - index of the first smallest, or largest if MAXIMUM, element, or -1 if the queue is empty.
+    */
+    template <bool MAXIMUM>
+    int extremeElement() const;
+
+    /* Bits of the key sorted by each pass of radixSortBy */
+    static const int RADIX_BITS = 8;
+
+    /* Number of buckets of each pass of radixSortBy */
+    static const int RADIX_BUCKETS = 1 << RADIX_BITS;
+
+    /* Below this size sort and stableSort compare elements instead of radix sorting, which has a fixed cost */
+    static const int RADIX_SORT_MIN_SIZE = 256;
+
+    /*
+     * linearize - moves the elements so that they are contiguous in the array, starting at m_firstIndex.
+     * Done in place, with O(size()) moves if the elements wrap around the end of the array, and none otherwise.
+     *
+     * @exception
+     * A random exception might be thrown by the move of T, in which case the queue holds valid but unspecified elements.
+    */
+    void linearize();
+
+    /*
+     * radixSortBy - stable LSD radix sort by an integral key, RADIX_BITS of it at a time.
+     * The keys are counted for every pass in one read of the elements, and a pass in which all the keys have
+     * the same digit is skipped. The passes move the elements between the array and a second array of the
+     * same size, and the queue keeps whichever of the two holds the result.
+     *
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the order of the elements is unchanged,
+     * as well as, a random exception might be thrown by key or by the move of T, in which case the queue
+     * holds valid but unspecified elements.
+    */
+    template <class Key>
+    void radixSortBy(const Key& key);
+
+    template <class U, class Condition>
+    friend Queue<U> filter(const Queue<U>& queue, const Condition& condition);
+
+    template <class U, class Result, class Operation>
+    friend Result reduce(const Queue<U>& queue, Result initial, const Operation& operation);
+
+    template <class U>
+    friend U sum(const Queue<U>& queue);
+
+    template <class U, class Condition>
+    friend int countIf(const Queue<U>& queue, const Condition& condition);
+
+    template <class U>
+    friend int minElement(const Queue<U>& queue);
+
+    template <class U>
+    friend int maxElement(const Queue<U>& queue);
+
+    template <class U, class Transform>
+    friend void transform(Queue<U>& queue, const Transform& transform);
+
+    template <class U, class Compare>
+    friend void sort(Queue<U>& queue, const Compare& compare);
+
+    template <class U>
+    friend void sort(Queue<U>& queue);
+
+    template <class U, class Compare>
+    friend void stableSort(Queue<U>& queue, const Compare& compare);
+
+    template <class U>
+    friend void stableSort(Queue<U>& queue);
+
+    template <class U, class Key>
+    friend void radixSort(Queue<U>& queue, const Key& key);
+
+    template <class U, class Compare>
+    friend Queue<U> merge(Queue<Queue<U>>& sortedQueues, const Compare& compare);
+
     /*
      * checkEmptyQueue - Checks if the queue is empty .
      * 
@@ -215,20 +599,20 @@ private:
 /* --------------------------------------- Public Functions of Queue Class ---------------------------------------*/
 
 template <class T>
-Queue<T>::Queue() : m_data(new T[INITIAL_SIZE]) , m_dataSize(INITIAL_SIZE) , m_currentIndex(FIRST_INDEX) {}
+Queue<T>::Queue() : m_data(allocateData(INITIAL_SIZE)) , m_dataSize(INITIAL_SIZE) , m_firstIndex(FIRST_INDEX) , m_size(0) {}
 
 template <class T>
 Queue<T>::~Queue(){
-    delete[] m_data;
+    deallocateData(m_data, m_dataSize);
 }
 
 template <class T>
-Queue<T>::Queue(const Queue& queue) : m_data(new T[queue.m_dataSize]), m_dataSize(queue.m_dataSize)
- , m_currentIndex(queue.m_currentIndex){
+Queue<T>::Queue(const Queue& queue) : m_data(allocateData(queue.m_dataSize)), m_dataSize(queue.m_dataSize)
+ , m_firstIndex(FIRST_INDEX) , m_size(queue.m_size){
     try{
         copyData(m_data,m_dataSize,queue);
     } catch(...){
-        delete[] m_data;
+        deallocateData(m_data, m_dataSize);
         throw;
     }
 }
@@ -239,50 +623,248 @@ Queue<T>& Queue<T>::operator=(const Queue& otherQueue){
         return *this;
     }
 
-    T* tempData = new T[otherQueue.m_dataSize];
+    T* tempData = allocateData(otherQueue.m_dataSize);
     try{
         copyData(tempData,otherQueue.m_dataSize,otherQueue);
     } catch(...) {
-        delete[] tempData;
+        deallocateData(tempData, otherQueue.m_dataSize);
         throw;
     }
     updateData(tempData);
     m_dataSize = otherQueue.m_dataSize;
-    m_currentIndex = otherQueue.m_currentIndex;
+    m_firstIndex = FIRST_INDEX;
+    m_size = otherQueue.m_size;
     return *this;
 
 }
 
 template <class T>
 void Queue<T>::pushBack(const T& argumentToAdd){
-    if(m_currentIndex == m_dataSize){
+    if(m_size == m_dataSize){
         this->expand();
     }
-    m_data[m_currentIndex++]= argumentToAdd;
+    m_data[physicalIndex(m_size)]= argumentToAdd;
+    m_size++;
+    QUEUE_TRACE(PUSH, this, m_size);
 }
 
 template <class T>
 T& Queue<T>::front(){
     checkEmptyQueue();
-    return m_data[FIRST_INDEX];
+    return m_data[m_firstIndex];
 }
 
 template <class T>
 const T& Queue<T>::front() const {
     checkEmptyQueue();
-    return m_data[FIRST_INDEX];
+    return m_data[m_firstIndex];
 }
 
 template <class T>
 void Queue<T>::popFront() {
     checkEmptyQueue();
-    compress();
+    removeFront();
+}
 
+template <class T>
+std::optional<T> Queue<T>::tryFront() const noexcept(std::is_nothrow_copy_constructible<T>::value){
+    if(m_size == 0){
+        return std::nullopt;
+    }
+    return std::optional<T>(m_data[m_firstIndex]);
+}
+
+template <class T>
+std::optional<T> Queue<T>::tryPopFront() noexcept(std::is_nothrow_move_constructible<T>::value){
+    if(m_size == 0){
+        return std::nullopt;
+    }
+    std::optional<T> result(std::move(m_data[m_firstIndex]));
+    removeFront();
+    return result;
+}
+
+template <class T>
+bool Queue<T>::popFrontInto(T& destination) noexcept(std::is_nothrow_move_assignable<T>::value){
+    if(m_size == 0){
+        return false;
+    }
+    destination = std::move(m_data[m_firstIndex]);
+    removeFront();
+    return true;
+}
+
+template <class T>
+T Queue<T>::popAndGet(){
+    checkEmptyQueue();
+    T result(std::move(m_data[m_firstIndex]));
+    removeFront();
+    return result;
 }
 
 template <class T>
 int Queue<T>::size() const{
-    return m_currentIndex;
+    return m_size;
+}
+
+template <class T>
+T& Queue<T>::operator[](int index){
+    assert(index >= 0 && index < m_size);
+    return m_data[physicalIndex(index)];
+}
+
+template <class T>
+const T& Queue<T>::operator[](int index) const{
+    assert(index >= 0 && index < m_size);
+    return m_data[physicalIndex(index)];
+}
+
+template <class T>
+T& Queue<T>::at(int index){
+    if(index < 0 || index >= m_size){
+        throw OutOfRange();
+    }
+    return m_data[physicalIndex(index)];
+}
+
+template <class T>
+const T& Queue<T>::at(int index) const{
+    if(index < 0 || index >= m_size){
+        throw OutOfRange();
+    }
+    return m_data[physicalIndex(index)];
+}
+
+template <class T>
+typename Queue<T>::Iterator Queue<T>::find(const T& value){
+    for(int i = 0 ; i < m_size ; i++){
+        if(m_data[physicalIndex(i)] == value){
+            return Iterator(this, i);
+        }
+    }
+    return end();
+}
+
+template <class T>
+typename Queue<T>::ConstIterator Queue<T>::find(const T& value) const{
+    for(int i = 0 ; i < m_size ; i++){
+        if(m_data[physicalIndex(i)] == value){
+            return ConstIterator(this, i);
+        }
+    }
+    return end();
+}
+
+template <class T>
+bool Queue<T>::contains(const T& value) const{
+    return find(value) != end();
+}
+
+template <class T>
+template <class Condition>
+int Queue<T>::eraseIf(const Condition& condition){
+    int kept = 0;
+    int next = 0;
+    try{
+        for( ; next < m_size ; next++){
+            T& data = m_data[physicalIndex(next)];
+            if(condition(data)){
+                continue;
+            }
+            if(kept != next){
+                m_data[physicalIndex(kept)] = std::move(data);
+            }
+            kept++;
+        }
+    } catch(...){
+        /* The elements from next on were not checked yet - close the gap before them and keep them */
+        for( ; next < m_size ; next++, kept++){
+            if(kept != next){
+                m_data[physicalIndex(kept)] = std::move(m_data[physicalIndex(next)]);
+            }
+        }
+        releaseElements(kept, m_size);
+        m_size = kept;
+        throw;
+    }
+    releaseElements(kept, m_size);
+    int removed = m_size - kept;
+    m_size = kept;
+    return removed;
+}
+
+template <class T>
+void Queue<T>::reserve(int capacity){
+    if(capacity <= m_dataSize){
+        return;
+    }
+    growTo(grownDataSize(capacity));
+}
+
+template <class T>
+void Queue<T>::splice(Queue& other){
+    if(this == &other || other.m_size == 0){
+        return;
+    }
+    if(m_size == 0){
+        swapData(other);
+        return;
+    }
+
+    if(m_size < other.m_size && other.m_dataSize - other.m_size >= m_size){
+        /* Our elements go in front of the elements of other, in its array, which then becomes ours */
+        while(m_size > 0){
+            int destination = other.m_firstIndex == 0 ? other.m_dataSize - 1 : other.m_firstIndex - 1;
+            other.m_data[destination] = std::move(m_data[physicalIndex(m_size - 1)]);
+            other.m_firstIndex = destination;
+            other.m_size++;
+            m_size--;
+        }
+        m_firstIndex = FIRST_INDEX;
+        swapData(other);
+        return;
+    }
+
+    reserve(m_size + other.m_size);
+    while(other.m_size > 0){
+        m_data[physicalIndex(m_size)] = std::move(other.m_data[other.m_firstIndex]);
+        m_size++;
+        other.m_firstIndex = other.physicalIndex(1);
+        other.m_size--;
+    }
+    other.m_firstIndex = FIRST_INDEX;
+}
+
+template <class T>
+Queue<T> Queue<T>::splitAt(int index){
+    if(index < 0 || index > m_size){
+        throw OutOfRange();
+    }
+
+    Queue<T> shorterPart;
+    bool tailIsShorter = m_size - index <= index;
+    int begin = tailIsShorter ? index : 0;
+    int end = tailIsShorter ? m_size : index;
+    shorterPart.reserve(end - begin);
+    /* Copied unless moving cannot throw, so the queue is unchanged if T throws */
+    for(int i = begin ; i < end ; i++){
+        shorterPart.m_data[shorterPart.m_size++] = std::move_if_noexcept(m_data[physicalIndex(i)]);
+    }
+
+    if(tailIsShorter){
+        m_size = index;
+        return shorterPart;
+    }
+    /* The head is the shorter part, so the tail keeps the current array and is returned */
+    swapData(shorterPart);
+    shorterPart.m_firstIndex = shorterPart.physicalIndex(index);
+    shorterPart.m_size -= index;
+    return shorterPart;
+}
+
+template <class T>
+void Queue<T>::swap(Queue& other) noexcept{
+    swapData(other);
 }
 
 template <class T>
@@ -292,7 +874,7 @@ typename Queue<T>::Iterator Queue<T>::begin(){
 
 template <class T>
 typename Queue<T>::Iterator Queue<T>::end() {
-    return Iterator(this,m_currentIndex);
+    return Iterator(this,m_size);
 }
 
 template <class T>
@@ -302,7 +884,7 @@ typename Queue<T>::ConstIterator Queue<T>::begin() const{
 
 template <class T>
 typename Queue<T>::ConstIterator Queue<T>::end() const{
-    return ConstIterator(this,m_currentIndex);
+    return ConstIterator(this,m_size);
 }
 
 
@@ -314,55 +896,423 @@ typename Queue<T>::ConstIterator Queue<T>::end() const{
 
 template <class T>
 void Queue<T>::expand(){
+    if(m_dataSize == std::numeric_limits<int>::max()){
+        throw std::bad_alloc();
+    }
+    growTo(grownDataSize(m_dataSize + 1));
+}
+
+template <class T>
+int Queue<T>::grownDataSize(int capacity) const noexcept{
+    int newDataSize = m_dataSize;
+    while(newDataSize < capacity){
+        if(newDataSize > std::numeric_limits<int>::max() / EXPAND_RATE){
+            return capacity;
+        }
+        newDataSize *= EXPAND_RATE;
+    }
+    return newDataSize;
+}
+
+template <class T>
+void Queue<T>::growTo(int newDataSize){
+    QUEUE_TRACE(GROW, this, newDataSize);
 
-    T* tempData = new T[EXPAND_RATE*m_dataSize];
+    if constexpr(TRIVIAL_DATA && USES_BUFFER_CACHE){
+        reallocateData(newDataSize);
+        return;
+    }
+
+    T* tempData = allocateData(newDataSize);
     try{
-        copyData(tempData,EXPAND_RATE*m_dataSize,*this);
+        copyData(tempData,newDataSize,*this);
     } catch(...){
-        delete[] tempData;
+        deallocateData(tempData, newDataSize);
         throw;
     }
     updateData(tempData);
-    m_dataSize= EXPAND_RATE*m_dataSize;
+    m_dataSize= newDataSize;
+    m_firstIndex = FIRST_INDEX;
 }
 
 template <class T>
-void Queue<T>::compress() {
+void Queue<T>::swapData(Queue& other) noexcept{
+    std::swap(m_data, other.m_data);
+    std::swap(m_dataSize, other.m_dataSize);
+    std::swap(m_firstIndex, other.m_firstIndex);
+    std::swap(m_size, other.m_size);
+}
 
-    T* tempData = new T[m_currentIndex];
+template <class T>
+void Queue<T>::compress() noexcept {
+    if(m_dataSize <= INITIAL_SIZE || m_size * EXPAND_RATE * EXPAND_RATE > m_dataSize){
+        return;
+    }
+
+    int newDataSize = m_dataSize / EXPAND_RATE;
+    T* tempData = nullptr;
     try{
-        copyData(tempData,m_currentIndex,*this);
-        for (int i=0 ; i < m_currentIndex - 1; i++){
-            tempData[i] = tempData[i+1];
-        }
+        tempData = allocateData(newDataSize);
+        copyData(tempData,newDataSize,*this);
     } catch(...) {
-        delete[] tempData;
-        throw;
+        deallocateData(tempData, newDataSize);
+        return;
     }
     updateData(tempData);
-    m_dataSize = m_currentIndex;
-    m_currentIndex--;
+    m_dataSize = newDataSize;
+    m_firstIndex = FIRST_INDEX;
+    QUEUE_TRACE(SHRINK, this, newDataSize);
+}
+
+template <class T>
+void Queue<T>::removeFront() noexcept {
+    releaseElements(0, 1);
+    m_firstIndex = physicalIndex(1);
+    m_size--;
+    QUEUE_TRACE(POP, this, m_size);
+    compress();
+}
+
+template <class T>
+void Queue<T>::releaseElements(int first, int last) noexcept {
+    if constexpr(!TRIVIAL_DATA){
+        /* The removed elements release what they hold now, rather than when their places are reused */
+        try{
+            for(int i = first ; i < last ; i++){
+                m_data[physicalIndex(i)] = T();
+            }
+        } catch(...) {
+        }
+    }
+}
+
+template <class T>
+int Queue<T>::physicalIndex(int index) const noexcept {
+    int physical = m_firstIndex + index;
+    return physical < m_dataSize ? physical : physical - m_dataSize;
 }
 
 template <class T>
 void Queue<T>::copyData(T* const destinationData, int destinationDataSize, const Queue<T>& sourceQueue){
 
-    for(int i = 0 ; i < sourceQueue.m_dataSize && i < destinationDataSize ; i++){
-        destinationData[i] = sourceQueue.m_data[i];
+    if constexpr(TRIVIAL_DATA){
+        int count = sourceQueue.m_size < destinationDataSize ? sourceQueue.m_size : destinationDataSize;
+        int firstSegment = sourceQueue.m_dataSize - sourceQueue.m_firstIndex;
+        if(firstSegment > count){
+            firstSegment = count;
+        }
+        std::memcpy(static_cast<void*>(destinationData), sourceQueue.m_data + sourceQueue.m_firstIndex,
+                    sizeof(T) * firstSegment);
+        std::memcpy(static_cast<void*>(destinationData + firstSegment), sourceQueue.m_data,
+                    sizeof(T) * (count - firstSegment));
+        return;
+    }
+
+    for(int i = 0 ; i < sourceQueue.m_size && i < destinationDataSize ; i++){
+        destinationData[i] = sourceQueue.m_data[sourceQueue.physicalIndex(i)];
     }
 
 }
 
 template <class T>
 void Queue<T>::updateData(T* newData) {
-    delete[] m_data;
+    deallocateData(m_data, m_dataSize);
+    m_data = newData;
+}
+
+template <class T>
+T* Queue<T>::allocateData(int size){
+    if constexpr(TRIVIAL_DATA){
+        return static_cast<T*>(allocateBlock(size));
+    }
+
+    T* data = static_cast<T*>(allocateBlock(size));
+    int constructed = 0;
+    try{
+        for( ; constructed < size ; constructed++){
+            new (data + constructed) T();
+        }
+    } catch(...){
+        deallocateData(data, constructed);
+        throw;
+    }
+    return data;
+}
+
+template <class T>
+void Queue<T>::deallocateData(T* data, int size){
+    if(data == nullptr){
+        return;
+    }
+    if constexpr(!TRIVIAL_DATA){
+        for(int i = 0 ; i < size ; i++){
+            data[i].~T();
+        }
+    }
+    freeBlock(data, size);
+}
+
+template <class T>
+void* Queue<T>::allocateBlock(int size){
+    if constexpr(USES_BUFFER_CACHE){
+        return QueueBufferCache::allocate(dataBytes(size));
+    }
+    void* block = std::aligned_alloc(DATA_ALIGNMENT, dataBytes(size));
+    if(block == nullptr){
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+template <class T>
+void Queue<T>::freeBlock(void* block, int size) noexcept{
+    if constexpr(USES_BUFFER_CACHE){
+        QueueBufferCache::deallocate(block, dataBytes(size));
+        return;
+    }
+    std::free(block);
+}
+
+template <class T>
+void Queue<T>::reallocateData(int newDataSize){
+    T* newData = static_cast<T*>(QueueBufferCache::reallocate(m_data, dataBytes(m_dataSize), dataBytes(newDataSize)));
+
+    /*
+     * Elements that wrapped around to the beginning move to the new space right after the old end. If the array
+     * grew by less than that, as it may near the largest size, the elements up to the old end move to the new end.
+    */
+    int wrappedElements = m_firstIndex + m_size - m_dataSize;
+    if(wrappedElements > 0 && wrappedElements <= newDataSize - m_dataSize){
+        std::memcpy(static_cast<void*>(newData + m_dataSize), newData, sizeof(T) * wrappedElements);
+    } else if(wrappedElements > 0){
+        int firstPart = m_dataSize - m_firstIndex;
+        std::memmove(static_cast<void*>(newData + newDataSize - firstPart), newData + m_firstIndex, sizeof(T) * firstPart);
+        m_firstIndex = newDataSize - firstPart;
+    }
     m_data = newData;
+    m_dataSize = newDataSize;
+}
+
+template <class T>
+std::size_t Queue<T>::dataBytes(int size){
+    std::size_t bytes = sizeof(T) * (size > 0 ? size : 1);
+    return (bytes + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+}
+
+template <class T>
+template <class Function>
+void Queue<T>::forEach(const Function& function){
+    int firstSegmentEnd = m_firstIndex + m_size < m_dataSize ? m_firstIndex + m_size : m_dataSize;
+    scanSegment(m_data + m_firstIndex, m_data + firstSegmentEnd, function);
+    scanSegment(m_data, m_data + (m_size - (firstSegmentEnd - m_firstIndex)), function);
+}
+
+template <class T>
+template <class Function>
+void Queue<T>::forEach(const Function& function) const{
+    int firstSegmentEnd = m_firstIndex + m_size < m_dataSize ? m_firstIndex + m_size : m_dataSize;
+    scanSegment(static_cast<const T*>(m_data + m_firstIndex), static_cast<const T*>(m_data + firstSegmentEnd), function);
+    scanSegment(static_cast<const T*>(m_data), static_cast<const T*>(m_data + (m_size - (firstSegmentEnd - m_firstIndex))),
+                function);
+}
+
+template <class T>
+template <class Element, class Function>
+void Queue<T>::scanSegment(Element* begin, Element* end, const Function& function){
+#if defined(__GNUC__) || defined(__clang__)
+    /* Elements smaller than a line are left to the hardware prefetcher, which handles sequential scans well */
+    if constexpr(sizeof(Element) >= CACHE_LINE_SIZE){
+        if(PREFETCH_DISTANCE > 0 && end - begin > PREFETCH_DISTANCE){
+            Element* prefetchEnd = end - PREFETCH_DISTANCE;
+            for( ; begin != prefetchEnd ; ++begin){
+                const char* ahead = reinterpret_cast<const char*>(begin + PREFETCH_DISTANCE);
+                for(std::size_t line = 0 ; line < sizeof(Element) ; line += CACHE_LINE_SIZE){
+                    __builtin_prefetch(ahead + line);
+                }
+                function(*begin);
+            }
+        }
+    }
+#endif
+    for( ; begin != end ; ++begin){
+        function(*begin);
+    }
+}
+
+template <class T>
+template <class Function>
+void Queue<T>::forEachSegment(const Function& function) const{
+    int firstSegmentEnd = m_firstIndex + m_size < m_dataSize ? m_firstIndex + m_size : m_dataSize;
+    function(static_cast<const T*>(m_data + m_firstIndex), static_cast<const T*>(m_data + firstSegmentEnd));
+    int wrappedElements = m_size - (firstSegmentEnd - m_firstIndex);
+    if(wrappedElements > 0){
+        function(static_cast<const T*>(m_data), static_cast<const T*>(m_data + wrappedElements));
+    }
+}
+
+template <class T>
+T Queue<T>::sumSegment(const T* begin, const T* end){
+    /* The lanes do not depend on each other, so the compiler keeps them in one vector register */
+    T lanes[REDUCTION_LANES] = {};
+    std::ptrdiff_t count = end - begin;
+    std::ptrdiff_t i = 0;
+    for( ; i + REDUCTION_LANES <= count ; i += REDUCTION_LANES){
+        for(int lane = 0 ; lane < REDUCTION_LANES ; lane++){
+            lanes[lane] += begin[i + lane];
+        }
+    }
+    T result = T();
+    for(int lane = 0 ; lane < REDUCTION_LANES ; lane++){
+        result += lanes[lane];
+    }
+    for( ; i < count ; i++){
+        result += begin[i];
+    }
+    return result;
+}
+
+template <class T>
+template <bool MAXIMUM>
+T Queue<T>::extremeOfSegment(const T* begin, const T* end){
+    T lanes[REDUCTION_LANES];
+    for(int lane = 0 ; lane < REDUCTION_LANES ; lane++){
+        lanes[lane] = *begin;
+    }
+    std::ptrdiff_t count = end - begin;
+    std::ptrdiff_t i = 0;
+    for( ; i + REDUCTION_LANES <= count ; i += REDUCTION_LANES){
+        for(int lane = 0 ; lane < REDUCTION_LANES ; lane++){
+            T value = begin[i + lane];
+            /* A select rather than a branch, so the loop becomes vector min / max instructions */
+            lanes[lane] = (MAXIMUM ? lanes[lane] < value : value < lanes[lane]) ? value : lanes[lane];
+        }
+    }
+    T result = lanes[0];
+    for(int lane = 1 ; lane < REDUCTION_LANES ; lane++){
+        result = (MAXIMUM ? result < lanes[lane] : lanes[lane] < result) ? lanes[lane] : result;
+    }
+    for( ; i < count ; i++){
+        result = (MAXIMUM ? result < begin[i] : begin[i] < result) ? begin[i] : result;
+    }
+    return result;
+}
+
+template <class T>
+template <bool MAXIMUM>
+int Queue<T>::extremeElement() const{
+    if(m_size == 0){
+        return -1;
+    }
+    if constexpr(std::is_integral<T>::value){
+        /* Integers that compare equal are the same, so the value is found first and then its first position */
+        T extreme = m_data[m_firstIndex];
+        forEachSegment([&extreme](const T* begin, const T* end) {
+            T segmentExtreme = extremeOfSegment<MAXIMUM>(begin, end);
+            extreme = (MAXIMUM ? extreme < segmentExtreme : segmentExtreme < extreme) ? segmentExtreme : extreme;
+        });
+        for(int i = 0 ; i < m_size ; i++){
+            if(m_data[physicalIndex(i)] == extreme){
+                return i;
+            }
+        }
+        return -1;
+    }
+    else{
+        const T* extreme = m_data + m_firstIndex;
+        int extremeIndex = 0;
+        int index = 0;
+        forEach([&extreme, &extremeIndex, &index](const T& data) {
+            if(MAXIMUM ? *extreme < data : data < *extreme){
+                extreme = &data;
+                extremeIndex = index;
+            }
+            index++;
+        });
+        return extremeIndex;
+    }
+}
+
+template <class T>
+void Queue<T>::linearize(){
+    int wrappedElements = m_firstIndex + m_size - m_dataSize;
+    if(wrappedElements <= 0){
+        return;
+    }
+    /*
+     * The first part moves down to right after the wrapped part, and then the two parts swap places.
+     * In a full array the first part is already right after the wrapped part.
+    */
+    if(wrappedElements < m_firstIndex){
+        std::move(m_data + m_firstIndex, m_data + m_dataSize, m_data + wrappedElements);
+    }
+    std::rotate(m_data, m_data + wrappedElements, m_data + m_size);
+    m_firstIndex = FIRST_INDEX;
+}
+
+template <class T>
+template <class Key>
+void Queue<T>::radixSortBy(const Key& key){
+    typedef decltype(key(std::declval<const T&>())) KeyType;
+    static_assert(std::is_integral<KeyType>::value && !std::is_same<KeyType, bool>::value,
+                  "radix sort requires a key of integral type");
+    typedef typename std::make_unsigned<KeyType>::type Digits;
+    const int PASSES = static_cast<int>(sizeof(KeyType) * 8 / RADIX_BITS);
+    /* Flipping the sign bit orders signed keys as unsigned ones */
+    const Digits SIGN_FLIP = std::is_signed<KeyType>::value ? static_cast<Digits>(Digits(1) << (sizeof(Digits) * 8 - 1)) : 0;
+
+    if(m_size < 2){
+        return;
+    }
+    linearize();
+    T* source = m_data + m_firstIndex;
+    int counts[PASSES][RADIX_BUCKETS] = {};
+    for(int i = 0 ; i < m_size ; i++){
+        Digits digits = static_cast<Digits>(key(source[i])) ^ SIGN_FLIP;
+        for(int pass = 0 ; pass < PASSES ; pass++){
+            counts[pass][(digits >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    T* secondData = allocateData(m_dataSize);
+    T* destination = secondData;
+    try{
+        for(int pass = 0 ; pass < PASSES ; pass++){
+            int shift = pass * RADIX_BITS;
+            int* passCounts = counts[pass];
+            Digits firstDigits = static_cast<Digits>(key(source[0])) ^ SIGN_FLIP;
+            if(passCounts[(firstDigits >> shift) & (RADIX_BUCKETS - 1)] == m_size){
+                continue;
+            }
+            int offsets[RADIX_BUCKETS];
+            int offset = 0;
+            for(int bucket = 0 ; bucket < RADIX_BUCKETS ; bucket++){
+                offsets[bucket] = offset;
+                offset += passCounts[bucket];
+            }
+            for(int i = 0 ; i < m_size ; i++){
+                Digits digits = static_cast<Digits>(key(source[i])) ^ SIGN_FLIP;
+                destination[offsets[(digits >> shift) & (RADIX_BUCKETS - 1)]++] = std::move(source[i]);
+            }
+            /* The next pass reads what this one wrote, and writes over the part this one read */
+            std::swap(source, destination);
+        }
+    } catch(...){
+        deallocateData(secondData, m_dataSize);
+        throw;
+    }
+
+    if(source == secondData){
+        updateData(secondData);
+        m_firstIndex = FIRST_INDEX;
+        return;
+    }
+    deallocateData(secondData, m_dataSize);
 }
 
 template <class T>
 void Queue<T>::checkEmptyQueue() const{
 
-    if(m_currentIndex == FIRST_INDEX){
+    if(m_size == 0){
         throw EmptyQueue();
     }
 }
@@ -388,12 +1338,14 @@ void Queue<T>::checkEmptyQueue() const{
 */
 template <class T,class Condition>
 Queue<T> filter(const Queue<T>& queue,const Condition& condition){
+    QUEUE_TRACE(FILTER_BEGIN, &queue, queue.size());
     Queue<T> resultQueue;
-    for(const T& data : queue){
+    queue.forEach([&resultQueue, &condition](const T& data) {
         if(condition(data)){
             resultQueue.pushBack(data);
         }
-    }
+    });
+    QUEUE_TRACE(FILTER_END, &queue, resultQueue.size());
     return resultQueue;
 }
 
@@ -408,10 +1360,312 @@ Queue<T> filter(const Queue<T>& queue,const Condition& condition){
 template <class T, class Transform>
 void transform(Queue<T>& queue, const Transform& transform){
     
-    for(T& data : queue){
+    queue.forEach([&transform](T& data) {
         transform(data);
+    });
+
+}
+
+/*
+ * reduce - Combines the elements of the queue in order, starting from an initial value.
+ *
+ * @param queue - The queue to reduce.
+ * @param initial - The value to start from.
+ * @param operation - Called as operation(result, element) for every element, returns the new result.
+ * @return
+ * Returns the result after the last element, or initial if the queue is empty.
+ * @exception
+ * A random exception might be thrown by operation.
+*/
+template <class T, class Result, class Operation>
+Result reduce(const Queue<T>& queue, Result initial, const Operation& operation){
+    queue.forEach([&initial, &operation](const T& data) {
+        initial = operation(initial, data);
+    });
+    return initial;
+}
+
+/*
+ * sum - Sum of the elements of a queue of arithmetic type, computed with vectorized partial sums.
+ * For floating point types the rounding may differ from adding the elements one by one.
+ *
+ * @param queue - The queue to sum.
+ * @return
+ * Returns the sum, or 0 if the queue is empty.
+*/
+template <class T>
+T sum(const Queue<T>& queue){
+    static_assert(std::is_arithmetic<T>::value, "sum requires an arithmetic type, use reduce otherwise");
+    T result = T();
+    queue.forEachSegment([&result](const T* begin, const T* end) {
+        result += Queue<T>::sumSegment(begin, end);
+    });
+    return result;
+}
+
+/*
+ * countIf - Counts the elements of the queue that satisfy the condition.
+ *
+ * @param queue - The queue to count in.
+ * @param condition - The condition to check.
+ * @return
+ * Returns the number of elements for which condition returned true.
+ * @exception
+ * A random exception might be thrown by condition.
+*/
+template <class T, class Condition>
+int countIf(const Queue<T>& queue, const Condition& condition){
+    int count = 0;
+    queue.forEachSegment([&count, &condition](const T* begin, const T* end) {
+        /* Counting without a branch lets a simple condition vectorize */
+        int segmentCount = 0;
+        for( ; begin != end ; ++begin){
+            segmentCount += condition(*begin) ? 1 : 0;
+        }
+        count += segmentCount;
+    });
+    return count;
+}
+
+/*
+ * minElement - Finds the smallest element of the queue according to operator<.
+ *
+ * @param queue - The queue to search.
+ * @return
+ * Returns the index of the first smallest element, or -1 if the queue is empty.
+ * @exception
+ * A random exception might be thrown by operator< of T.
+*/
+template <class T>
+int minElement(const Queue<T>& queue){
+    return queue.template extremeElement<false>();
+}
+
+/*
+ * maxElement - Finds the largest element of the queue according to operator<.
+ *
+ * @param queue - The queue to search.
+ * @return
+ * Returns the index of the first largest element, or -1 if the queue is empty.
+ * @exception
+ * A random exception might be thrown by operator< of T.
+*/
+template <class T>
+int maxElement(const Queue<T>& queue){
+    return queue.template extremeElement<true>();
+}
+
+/*
+ * QueueRadixKey - Whether sort and stableSort radix sort a Queue<T>, and the key they sort it by.
+ * Integer types are their own key. Other types are radix sorted if a radixKey(const T&) that returns an integer
+ * is found for them, and that integer must order the elements as operator< does, as for HealthPoints.
+*/
+template <class T, class = void>
+struct QueueRadixKey {
+    static const bool EXISTS = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+    static T get(const T& data) { return data; }
+};
+
+template <class T>
+struct QueueRadixKey<T, std::void_t<decltype(radixKey(std::declval<const T&>()))>> {
+    static const bool EXISTS = true;
+    static auto get(const T& data) { return radixKey(data); }
+};
+
+/*
+ * sort - Sorts the queue in place according to compare, with std::sort on the array of the queue.
+ * Elements that wrap around the end of the array are first moved to be contiguous with the others.
+ *
+ * @param queue - The queue to sort.
+ * @param compare - Called as compare(element1, element2), returns true if element1 goes before element2.
+ * @exception
+ * A random exception might be thrown by compare or by the move of T,
+ * in which case the queue holds valid but unspecified elements.
+*/
+template <class T, class Compare>
+void sort(Queue<T>& queue, const Compare& compare){
+    queue.linearize();
+    T* begin = queue.m_data + queue.m_firstIndex;
+    std::sort(begin, begin + queue.m_size, compare);
+}
+
+/*
+ * sort - Sorts the queue in place according to operator<. Queues that QueueRadixKey allows, of at least
+ * RADIX_SORT_MIN_SIZE elements, are radix sorted, which allocates a second array for the duration of the sort.
+ *
+ * @param queue - The queue to sort.
+ * @exception
+ * std::bad_alloc exception might be thrown,
+ * as well as, a random exception might be thrown by operator< or by the move of T,
+ * in which case the queue holds valid but unspecified elements.
+*/
+template <class T>
+void sort(Queue<T>& queue){
+    if constexpr(QueueRadixKey<T>::EXISTS){
+        if(queue.m_size >= Queue<T>::RADIX_SORT_MIN_SIZE){
+            queue.radixSortBy([](const T& data) { return QueueRadixKey<T>::get(data); });
+            return;
+        }
+    }
+    sort(queue, [](const T& data1, const T& data2) { return data1 < data2; });
+}
+
+/*
+ * stableSort - Sorts the queue in place according to compare, keeping the order of equal elements,
+ * with std::stable_sort on the array of the queue.
+ *
+ * @param queue - The queue to sort.
+ * @param compare - Called as compare(element1, element2), returns true if element1 goes before element2.
+ * @exception
+ * A random exception might be thrown by compare or by the move of T,
+ * in which case the queue holds valid but unspecified elements.
+*/
+template <class T, class Compare>
+void stableSort(Queue<T>& queue, const Compare& compare){
+    queue.linearize();
+    T* begin = queue.m_data + queue.m_firstIndex;
+    std::stable_sort(begin, begin + queue.m_size, compare);
+}
+
+/*
+ * stableSort - Sorts the queue in place according to operator<, keeping the order of equal elements.
+ * Radix sorted like sort, as the radix sort is stable.
+ *
+ * @param queue - The queue to sort.
+ * @exception
+ * std::bad_alloc exception might be thrown,
+ * as well as, a random exception might be thrown by operator< or by the move of T,
+ * in which case the queue holds valid but unspecified elements.
+*/
+template <class T>
+void stableSort(Queue<T>& queue){
+    if constexpr(QueueRadixKey<T>::EXISTS){
+        if(queue.m_size >= Queue<T>::RADIX_SORT_MIN_SIZE){
+            queue.radixSortBy([](const T& data) { return QueueRadixKey<T>::get(data); });
+            return;
+        }
+    }
+    stableSort(queue, [](const T& data1, const T& data2) { return data1 < data2; });
+}
+
+/*
+ * radixSort - Sorts the queue by a key with a stable LSD radix sort, in O(size() * passes), one pass for every
+ * RADIX_BITS of the key in which the keys differ. A second array is allocated for the duration of the sort.
+ *
+ * @param queue - The queue to sort.
+ * @param key - Called as key(element), returns an integer, the elements are sorted from the lowest key up.
+ * @exception
+ * std::bad_alloc exception might be thrown, in which case the order of the elements is unchanged,
+ * as well as, a random exception might be thrown by key or by the move of T,
+ * in which case the queue holds valid but unspecified elements.
+*/
+template <class T, class Key>
+void radixSort(Queue<T>& queue, const Key& key){
+    queue.radixSortBy(key);
+}
+
+/*
+ * merge - Merges queues that are each sorted according to compare into a single sorted queue.
+ * The elements are moved, leaving the queues empty, and equal elements keep the order of their queues.
+ * The queue to take the next element from is found with a binary heap of the queues, so merging k queues
+ * takes O(log k) comparisons per element. Queues that wrap around the end of their array are first made
+ * contiguous, as in sort.
+ *
+ * @param sortedQueues - The queues to merge.
+ * @param compare - Called as compare(element1, element2), returns true if element1 goes before element2.
+ * @return
+ * Returns the sorted queue of all the elements.
+ * @exception
+ * std::bad_alloc exception might be thrown, in which case the queues are unchanged,
+ * as well as, a random exception might be thrown by compare or by the move of T,
+ * in which case the queues hold valid but unspecified elements.
+*/
+template <class T, class Compare>
+Queue<T> merge(Queue<Queue<T>>& sortedQueues, const Compare& compare){
+    /* The unmerged part of a queue, which is made contiguous so that it is read through a pointer */
+    struct Cursor {
+        T* m_next;
+        T* m_end;
+        int m_source;
+    };
+    Queue<Cursor> heap;
+    int totalSize = 0;
+    for(int i = 0 ; i < sortedQueues.size() ; i++){
+        if(sortedQueues[i].size() > 0){
+            heap.pushBack(Cursor());
+            totalSize += sortedQueues[i].size();
+        }
+    }
+    Queue<T> result;
+    result.reserve(totalSize);
+    /* The queues are emptied by swapping them with new ones, made before any element is moved out */
+    Queue<Queue<T>> emptyQueues;
+    for(int i = 0 ; i < sortedQueues.size() ; i++){
+        emptyQueues.pushBack(Queue<T>());
+    }
+    int heapSize = 0;
+    for(int i = 0 ; i < sortedQueues.size() ; i++){
+        Queue<T>& sortedQueue = sortedQueues[i];
+        if(sortedQueue.m_size > 0){
+            sortedQueue.linearize();
+            T* begin = sortedQueue.m_data + sortedQueue.m_firstIndex;
+            heap[heapSize++] = Cursor{ begin, begin + sortedQueue.m_size, i };
+        }
     }
 
+    auto before = [&compare](const Cursor& cursor1, const Cursor& cursor2) {
+        return compare(*cursor1.m_next, *cursor2.m_next)
+            || (!compare(*cursor2.m_next, *cursor1.m_next) && cursor1.m_source < cursor2.m_source);
+    };
+    auto siftDown = [&heap, &heapSize, &before](int place) {
+        while(true){
+            int first = place;
+            int left = 2 * place + 1;
+            if(left < heapSize && before(heap[left], heap[first])){
+                first = left;
+            }
+            if(left + 1 < heapSize && before(heap[left + 1], heap[first])){
+                first = left + 1;
+            }
+            if(first == place){
+                return;
+            }
+            std::swap(heap[place], heap[first]);
+            place = first;
+        }
+    };
+    for(int place = heapSize / 2 - 1 ; place >= 0 ; place--){
+        siftDown(place);
+    }
+
+    while(heapSize > 1){
+        Cursor& top = heap[0];
+        result.m_data[result.m_size++] = std::move(*top.m_next);
+        if(++top.m_next == top.m_end){
+            top = heap[--heapSize];
+        }
+        siftDown(0);
+    }
+    /* The last queue left is moved as is */
+    if(heapSize == 1){
+        for(T* next = heap[0].m_next ; next != heap[0].m_end ; ++next){
+            result.m_data[result.m_size++] = std::move(*next);
+        }
+    }
+
+    for(int i = 0 ; i < sortedQueues.size() ; i++){
+        sortedQueues[i].swapData(emptyQueues[i]);
+    }
+    return result;
+}
+
+/*
+ * merge - Merges queues that are each sorted according to operator< into a single sorted queue.
+ * See merge above.
+*/
+template <class T>
+Queue<T> merge(Queue<Queue<T>>& sortedQueues){
+    return merge(sortedQueues, [](const T& data1, const T& data2) { return data1 < data2; });
 }
 
 /* ----------------------------------- End of Additional Functions of Interface -----------------------------------*/
@@ -509,7 +1763,7 @@ private:
 template <class T>
 T& Queue<T>::Iterator::operator*() const {
     checkInvalidOperation();
-    return m_queue->m_data[m_index];
+    return m_queue->m_data[m_queue->physicalIndex(m_index)];
 }
 
 template <class T>
@@ -649,7 +1903,7 @@ template <class T>
 const T& Queue<T>::ConstIterator::operator*() const{
 
     checkInvalidOperation();
-    return m_queue->m_data[m_index];
+    return m_queue->m_data[m_queue->physicalIndex(m_index)];
 }
 
 template <class T>
@@ -700,4 +1954,4 @@ void Queue<T>::ConstIterator::checkInvalidOperation() const{
 
 /* ------------------------------------------- End of ConstIterator Class -------------------------------------------*/
 
-#endif //Queue_H
\ No newline at end of file
+#endif //Queue_H
\ No newline at end of file
@@ -0,0 +1,321 @@
+#ifndef QUEUE_BUFFER_CACHE_H
+#define QUEUE_BUFFER_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/* How many free arrays each thread keeps per size class by default, 0 disables the cache */
+#ifndef QUEUE_BUFFER_CACHE_BLOCKS
+#define QUEUE_BUFFER_CACHE_BLOCKS 8
+#endif
+
+/* The largest array, in bytes, that is kept in the cache. Larger arrays go straight back to the allocator */
+#ifndef QUEUE_BUFFER_CACHE_MAX_BYTES
+#define QUEUE_BUFFER_CACHE_MAX_BYTES (1 << 20)
+#endif
+
+
+/*
+ * QueueBufferCache - Per thread cache of the cache line aligned arrays used by Queue<T>.
+ * Freed arrays are kept in free lists by size class (powers of two bytes), and allocations take from
+ * the free list of their class before calling the allocator, so the short lived queues of filter() and
+ * the arrays given up by expand() and compress() are reused instead of freed and allocated again.
+ *
+ * The arrays are plain std::aligned_alloc memory, so an array may be freed by a thread other than the one
+ * that allocated it - it then joins the free list of the freeing thread. A thread's cached arrays are
+ * freed when it exits.
+*/
+class QueueBufferCache {
+
+public:
+
+    /* The alignment of every array from the cache */
+    static const std::size_t ALIGNMENT = 64;
+
+    /*
+     * Statistics - counters of the calling thread's cache.
+     * m_hits and m_misses count allocations served from a free list or by the allocator, and
+     * m_cached and m_freed count arrays kept in a free list or given back to the allocator.
+    */
+    struct Statistics {
+        long long m_hits = 0;
+        long long m_misses = 0;
+        long long m_cached = 0;
+        long long m_freed = 0;
+    };
+
+    /*
+     * allocate - an array of at least the given number of bytes, aligned to ALIGNMENT.
+     *
+     * @param bytes - the size of the array, a multiple of ALIGNMENT.
+     * @return
+     * Returns the array.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    static void* allocate(std::size_t bytes);
+
+    /*
+     * deallocate - gives back an array from allocate or reallocate.
+     *
+     * @param block - the array, may be nullptr.
+     * @param bytes - the size the array was requested with.
+    */
+    static void deallocate(void* block, std::size_t bytes) noexcept;
+
+    /*
+     * reallocate - grows or shrinks an array, keeping its content up to the smaller of the two sizes.
+     * The array is kept if the new size is in its size class, else the content is copied to a cached array of
+     * the new size class if there is one, or to a newly allocated one.
+     *
+     * @param block - the array.
+     * @param bytes - the size the array was requested with.
+     * @param newBytes - the new size, a multiple of ALIGNMENT.
+     * @return
+     * Returns the resized array, aligned to ALIGNMENT.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case block is unchanged.
+    */
+    static void* reallocate(void* block, std::size_t bytes, std::size_t newBytes);
+
+    /*
+     * setMaxBlocksPerClass - sets how many free arrays the calling thread keeps per size class.
+     * Arrays already cached beyond the new limit are freed.
+     *
+     * @param maxBlocksPerClass - the limit, 0 disables the cache for the calling thread.
+    */
+    static void setMaxBlocksPerClass(int maxBlocksPerClass) noexcept;
+
+    /*
+     * maxBlocksPerClass - how many free arrays the calling thread keeps per size class.
+    */
+    static int maxBlocksPerClass() noexcept;
+
+    /*
+     * statistics - the counters of the calling thread since it started or since resetStatistics.
+    */
+    static Statistics statistics() noexcept;
+
+    /*
+     * resetStatistics - sets the counters of the calling thread to zero.
+    */
+    static void resetStatistics() noexcept;
+
+    /*
+     * trim - frees every array cached by the calling thread.
+    */
+    static void trim() noexcept;
+
+private:
+
+    static const int MIN_CLASS_SHIFT = 6;
+    static const int NUMBER_OF_CLASSES = 26;
+
+    /*
+     * ThreadCache - the free lists of a thread. A free array holds the pointer to the next one in its first bytes.
+     * Trivially destructible, so it stays usable by the destructors of thread_local and static queues
+     * that run after the cached arrays were released.
+    */
+    struct ThreadCache {
+        void* m_heads[NUMBER_OF_CLASSES] = {};
+        int m_counts[NUMBER_OF_CLASSES] = {};
+        int m_maxBlocksPerClass = QUEUE_BUFFER_CACHE_BLOCKS;
+        bool m_released = false;
+        bool m_releaserRegistered = false;
+        Statistics m_statistics;
+    };
+
+    /*
+     * Releaser - frees the cached arrays of a thread when it exits.
+    */
+    struct Releaser {
+        ~Releaser();
+    };
+
+    /*
+     * threadCache - the cache of the calling thread.
+    */
+    static ThreadCache& threadCache() noexcept;
+
+    /*
+     * sizeClass - the size class of an array of the given size, or -1 if such arrays are not cached.
+    */
+    static int sizeClass(std::size_t bytes) noexcept;
+
+    /*
+     * classBytes - the size of the arrays of a size class.
+    */
+    static std::size_t classBytes(int sizeClass) noexcept;
+
+    /*
+     * allocationBytes - how many bytes to ask the allocator for, for an array of the given size.
+    */
+    static std::size_t allocationBytes(std::size_t bytes) noexcept;
+
+    /*
+     * takeCached - removes an array from the free list of the size class, or returns nullptr if it is empty.
+    */
+    static void* takeCached(ThreadCache& cache, int sizeClass) noexcept;
+
+    /*
+     * freeClass - frees cached arrays of the size class until at most keep are left.
+    */
+    static void freeClass(ThreadCache& cache, int sizeClass, int keep) noexcept;
+};
+
+
+/* ------------------------------------ Public Functions of QueueBufferCache Class ------------------------------------*/
+
+inline void* QueueBufferCache::allocate(std::size_t bytes){
+    ThreadCache& cache = threadCache();
+    int blockClass = sizeClass(bytes);
+    if(blockClass >= 0){
+        void* block = takeCached(cache, blockClass);
+        if(block != nullptr){
+            cache.m_statistics.m_hits++;
+            return block;
+        }
+    }
+    cache.m_statistics.m_misses++;
+    void* block = std::aligned_alloc(ALIGNMENT, allocationBytes(bytes));
+    if(block == nullptr){
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+inline void QueueBufferCache::deallocate(void* block, std::size_t bytes) noexcept{
+    if(block == nullptr){
+        return;
+    }
+    ThreadCache& cache = threadCache();
+    int blockClass = sizeClass(bytes);
+    bool aligned = reinterpret_cast<std::uintptr_t>(block) % ALIGNMENT == 0;
+    if(blockClass < 0 || !aligned || cache.m_released || cache.m_counts[blockClass] >= cache.m_maxBlocksPerClass){
+        cache.m_statistics.m_freed++;
+        std::free(block);
+        return;
+    }
+    if(!cache.m_releaserRegistered){
+        /* Constructed on first use, so threads that never cache an array do not pay for the registration */
+        static thread_local Releaser t_releaser;
+        (void)t_releaser;
+        cache.m_releaserRegistered = true;
+    }
+    *static_cast<void**>(block) = cache.m_heads[blockClass];
+    cache.m_heads[blockClass] = block;
+    cache.m_counts[blockClass]++;
+    cache.m_statistics.m_cached++;
+}
+
+inline void* QueueBufferCache::reallocate(void* block, std::size_t bytes, std::size_t newBytes){
+    ThreadCache& cache = threadCache();
+    int newClass = sizeClass(newBytes);
+    if(newClass >= 0 && newClass == sizeClass(bytes)){
+        /* The array was allocated with the size of its class, so it is big enough already */
+        return block;
+    }
+    /* std::realloc only promises malloc's alignment, so the content is copied to an aligned array instead */
+    void* newBlock = newClass >= 0 ? takeCached(cache, newClass) : nullptr;
+    if(newBlock != nullptr){
+        cache.m_statistics.m_hits++;
+    } else {
+        cache.m_statistics.m_misses++;
+        newBlock = std::aligned_alloc(ALIGNMENT, allocationBytes(newBytes));
+        if(newBlock == nullptr){
+            throw std::bad_alloc();
+        }
+    }
+    std::memcpy(newBlock, block, bytes < newBytes ? bytes : newBytes);
+    deallocate(block, bytes);
+    return newBlock;
+}
+
+inline void QueueBufferCache::setMaxBlocksPerClass(int maxBlocksPerClass) noexcept{
+    ThreadCache& cache = threadCache();
+    cache.m_maxBlocksPerClass = maxBlocksPerClass > 0 ? maxBlocksPerClass : 0;
+    for(int i = 0 ; i < NUMBER_OF_CLASSES ; i++){
+        freeClass(cache, i, cache.m_maxBlocksPerClass);
+    }
+}
+
+inline int QueueBufferCache::maxBlocksPerClass() noexcept{
+    return threadCache().m_maxBlocksPerClass;
+}
+
+inline QueueBufferCache::Statistics QueueBufferCache::statistics() noexcept{
+    return threadCache().m_statistics;
+}
+
+inline void QueueBufferCache::resetStatistics() noexcept{
+    threadCache().m_statistics = Statistics();
+}
+
+inline void QueueBufferCache::trim() noexcept{
+    ThreadCache& cache = threadCache();
+    for(int i = 0 ; i < NUMBER_OF_CLASSES ; i++){
+        freeClass(cache, i, 0);
+    }
+}
+
+/* --------------------------------- End of Public Functions of QueueBufferCache Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of QueueBufferCache Class ------------------------------------*/
+
+inline QueueBufferCache::Releaser::~Releaser(){
+    trim();
+    threadCache().m_released = true;
+}
+
+inline QueueBufferCache::ThreadCache& QueueBufferCache::threadCache() noexcept{
+    static thread_local ThreadCache t_cache;
+    return t_cache;
+}
+
+inline int QueueBufferCache::sizeClass(std::size_t bytes) noexcept{
+    if(bytes > static_cast<std::size_t>(QUEUE_BUFFER_CACHE_MAX_BYTES)){
+        return -1;
+    }
+    int blockClass = 0;
+    while(classBytes(blockClass) < bytes){
+        blockClass++;
+    }
+    return blockClass < NUMBER_OF_CLASSES ? blockClass : -1;
+}
+
+inline std::size_t QueueBufferCache::classBytes(int sizeClass) noexcept{
+    return static_cast<std::size_t>(1) << (sizeClass + MIN_CLASS_SHIFT);
+}
+
+inline std::size_t QueueBufferCache::allocationBytes(std::size_t bytes) noexcept{
+    int blockClass = sizeClass(bytes);
+    if(blockClass >= 0){
+        return classBytes(blockClass);
+    }
+    return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+inline void* QueueBufferCache::takeCached(ThreadCache& cache, int sizeClass) noexcept{
+    void* block = cache.m_heads[sizeClass];
+    if(block != nullptr){
+        cache.m_heads[sizeClass] = *static_cast<void**>(block);
+        cache.m_counts[sizeClass]--;
+    }
+    return block;
+}
+
+inline void QueueBufferCache::freeClass(ThreadCache& cache, int sizeClass, int keep) noexcept{
+    while(cache.m_counts[sizeClass] > keep){
+        std::free(takeCached(cache, sizeClass));
+        cache.m_statistics.m_freed++;
+    }
+}
+
+/* -------------------------------- End of Private Functions of QueueBufferCache Class --------------------------------*/
+
+#endif //QUEUE_BUFFER_CACHE_H
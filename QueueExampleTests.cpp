@@ -1,6 +1,13 @@
 
 #include "Queue.h"
+#include "HealthPoints.h"
 #include "iostream"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
 
@@ -121,4 +128,535 @@ bool testConstQueue()
 	return testResult;
 }
 
+bool testNonThrowingPop()
+{
+	bool testResult = true;
+
+	Queue<int> queue7;
+	AGREGATE_TEST_RESULT(testResult, !queue7.tryFront());
+	AGREGATE_TEST_RESULT(testResult, !queue7.tryPopFront());
+	int value = -1;
+	AGREGATE_TEST_RESULT(testResult, !queue7.popFrontInto(value) && value == -1);
+
+	for (int i = 1; i <= 100; i++) {
+		queue7.pushBack(i);
+	}
+	AGREGATE_TEST_RESULT(testResult, queue7.tryFront().value() == 1);
+	AGREGATE_TEST_RESULT(testResult, queue7.tryPopFront().value() == 1);
+	AGREGATE_TEST_RESULT(testResult, queue7.popFrontInto(value) && value == 2);
+	AGREGATE_TEST_RESULT(testResult, queue7.popAndGet() == 3);
+	AGREGATE_TEST_RESULT(testResult, queue7.size() == 97);
+
+	/* interleave pops and pushes so the elements wrap around the array */
+	for (int i = 101; i <= 200; i++) {
+		queue7.popFront();
+		queue7.pushBack(i);
+	}
+	int expected = 104;
+	for (int data : queue7) {
+		AGREGATE_TEST_RESULT(testResult, data == expected);
+		expected++;
+	}
+	AGREGATE_TEST_RESULT(testResult, expected == 201);
+
+	while (queue7.popFrontInto(value)) {
+	}
+	AGREGATE_TEST_RESULT(testResult, value == 200 && queue7.size() == 0);
+
+	bool exceptionThrown = false;
+	try {
+		queue7.popAndGet();
+	}
+	catch (Queue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	/* a popped element is released, not kept in the array */
+	std::shared_ptr<int> shared = std::make_shared<int>(7);
+	Queue<std::shared_ptr<int>> sharedQueue;
+	sharedQueue.pushBack(shared);
+	sharedQueue.pushBack(shared);
+	sharedQueue.pushBack(shared);
+	AGREGATE_TEST_RESULT(testResult, shared.use_count() == 4);
+	sharedQueue.popFront();
+	AGREGATE_TEST_RESULT(testResult, shared.use_count() == 3);
+	std::shared_ptr<int> popped;
+	AGREGATE_TEST_RESULT(testResult, sharedQueue.popFrontInto(popped) && shared.use_count() == 3);
+	popped.reset();
+	sharedQueue.popAndGet();
+	AGREGATE_TEST_RESULT(testResult, shared.use_count() == 1 && sharedQueue.size() == 0);
+
+	return testResult;
+}
+
+/*
+ * Runs the same mix of operations on a queue, wrapping around, growing, shrinking and copying it.
+ * makeValue(i) must return distinct values for distinct i.
+*/
+template <class T, class MakeValue>
+static bool checkDataOperations(const MakeValue& makeValue)
+{
+	bool testResult = true;
+
+	Queue<T> queue;
+	int nextPush = 0;
+	int nextPop = 0;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 7; i++) {
+			queue.pushBack(makeValue(nextPush++));
+		}
+		for (int i = 0; i < 5; i++) {
+			AGREGATE_TEST_RESULT(testResult, queue.popAndGet() == makeValue(nextPop++));
+		}
+	}
+	for (int i = 0; i < 1000; i++) {
+		queue.pushBack(makeValue(nextPush++));
+	}
+
+	Queue<T> copy = queue;
+	Queue<T> assigned;
+	assigned.pushBack(makeValue(-1));
+	assigned = queue;
+	AGREGATE_TEST_RESULT(testResult, copy.size() == queue.size() && assigned.size() == queue.size());
+
+	int expected = nextPop;
+	for (const T& data : copy) {
+		AGREGATE_TEST_RESULT(testResult, data == makeValue(expected++));
+	}
+	while (queue.size() > 0) {
+		AGREGATE_TEST_RESULT(testResult, queue.popAndGet() == makeValue(nextPop));
+		AGREGATE_TEST_RESULT(testResult, assigned.popAndGet() == makeValue(nextPop));
+		nextPop++;
+	}
+	AGREGATE_TEST_RESULT(testResult, nextPop == nextPush && assigned.size() == 0);
+
+	return testResult;
+}
+
+struct Point {
+	int m_x = 1;
+	int m_y = 2;
+
+	bool operator==(const Point& other) const
+	{
+		return m_x == other.m_x && m_y == other.m_y;
+	}
+};
+
+bool testTrivialAndGenericData()
+{
+	bool testResult = true;
+
+	AGREGATE_TEST_RESULT(testResult, Queue<int>::TRIVIAL_DATA);
+	AGREGATE_TEST_RESULT(testResult, Queue<Point>::TRIVIAL_DATA);
+	AGREGATE_TEST_RESULT(testResult, !Queue<std::string>::TRIVIAL_DATA);
+
+	AGREGATE_TEST_RESULT(testResult, checkDataOperations<int>([](int i) { return i; }));
+	AGREGATE_TEST_RESULT(testResult, checkDataOperations<Point>([](int i) { return Point{ i, -i }; }));
+	AGREGATE_TEST_RESULT(testResult, checkDataOperations<std::string>([](int i) {
+		return std::string("a rather long string, to leave the small buffer ") + std::to_string(i);
+	}));
+
+	return testResult;
+}
+
+bool testRandomAccess()
+{
+	bool testResult = true;
+
+	Queue<int> queue8;
+	for (int i = 0; i < 20; i++) {
+		queue8.pushBack(i);
+	}
+	for (int i = 0; i < 5; i++) {
+		queue8.popFront();
+		queue8.pushBack(20 + i);
+	}
+	/* the queue holds 5..24, wrapped around the array */
+	AGREGATE_TEST_RESULT(testResult, queue8[0] == 5 && queue8[19] == 24);
+	queue8.at(3) = 100;
+	AGREGATE_TEST_RESULT(testResult, queue8[3] == 100);
+
+	bool exceptionThrown = false;
+	try {
+		queue8.at(20);
+	}
+	catch (Queue<int>::OutOfRange& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	AGREGATE_TEST_RESULT(testResult, queue8.contains(24) && !queue8.contains(8));
+	Queue<int>::Iterator found = queue8.find(100);
+	AGREGATE_TEST_RESULT(testResult, found != queue8.end() && *found == 100);
+	*found = 8;
+	AGREGATE_TEST_RESULT(testResult, !(queue8.find(100) != queue8.end()));
+
+	const Queue<int> constQueue = queue8;
+	AGREGATE_TEST_RESULT(testResult, constQueue.at(19) == 24 && constQueue.contains(8));
+
+	int removed = queue8.eraseIf(isEven);
+	AGREGATE_TEST_RESULT(testResult, removed == 10 && queue8.size() == 10);
+	int expected = 5;
+	for (int data : queue8) {
+		AGREGATE_TEST_RESULT(testResult, data == expected);
+		expected += 2;
+	}
+	AGREGATE_TEST_RESULT(testResult, queue8.eraseIf(isEven) == 0 && queue8.size() == 10);
+
+	/* erased elements are released, and the array is kept as is */
+	std::shared_ptr<int> shared = std::make_shared<int>(1);
+	Queue<std::shared_ptr<int>> sharedQueue;
+	for (int i = 0; i < 100; i++) {
+		sharedQueue.pushBack(i % 10 == 0 ? std::make_shared<int>(i) : shared);
+	}
+	QueueBufferCache::Statistics before = QueueBufferCache::statistics();
+	int erased = sharedQueue.eraseIf([&shared](const std::shared_ptr<int>& data) { return data == shared; });
+	QueueBufferCache::Statistics after = QueueBufferCache::statistics();
+	AGREGATE_TEST_RESULT(testResult, erased == 90 && sharedQueue.size() == 10 && shared.use_count() == 1);
+	AGREGATE_TEST_RESULT(testResult, after.m_hits == before.m_hits && after.m_misses == before.m_misses);
+	AGREGATE_TEST_RESULT(testResult, *sharedQueue[9] == 90);
+
+	return testResult;
+}
+
+bool testBufferCache()
+{
+	bool testResult = true;
+
+	int previousMaxBlocks = QueueBufferCache::maxBlocksPerClass();
+	QueueBufferCache::setMaxBlocksPerClass(4);
+	{
+		Queue<int> warmUp;
+	}
+	QueueBufferCache::resetStatistics();
+	for (int i = 0; i < 100; i++) {
+		Queue<int> queue9;
+		for (int j = 0; j < 100; j++) {
+			queue9.pushBack(j);
+		}
+		Queue<int> filtered = filter(queue9, isEven);
+		AGREGATE_TEST_RESULT(testResult, filtered.size() == 50 && filtered.front() == 0);
+	}
+	QueueBufferCache::Statistics statistics = QueueBufferCache::statistics();
+	AGREGATE_TEST_RESULT(testResult, statistics.m_hits > 0 && statistics.m_hits > 10 * statistics.m_misses);
+
+	/* arrays allocated by one thread and freed by another */
+	Queue<std::string>* queue10 = new Queue<std::string>();
+	for (int i = 0; i < 50; i++) {
+		queue10->pushBack("migrating");
+	}
+	std::thread([queue10]() {
+		delete queue10;
+		Queue<std::string> localQueue;
+		localQueue.pushBack("local");
+	}).join();
+
+	/* resized arrays keep their content and alignment, also past the largest cached size */
+	std::size_t bytes = QueueBufferCache::ALIGNMENT;
+	unsigned char* block = static_cast<unsigned char*>(QueueBufferCache::allocate(bytes));
+	block[0] = 42;
+	for (int i = 0; i < 8; i++) {
+		block = static_cast<unsigned char*>(QueueBufferCache::reallocate(block, bytes, bytes * 4));
+		bytes *= 4;
+		block[bytes - 1] = 1;
+		AGREGATE_TEST_RESULT(testResult, reinterpret_cast<std::uintptr_t>(block) % QueueBufferCache::ALIGNMENT == 0);
+		AGREGATE_TEST_RESULT(testResult, block[0] == 42);
+	}
+	QueueBufferCache::deallocate(block, bytes);
+
+	QueueBufferCache::setMaxBlocksPerClass(0);
+	QueueBufferCache::resetStatistics();
+	{
+		Queue<int> queue11;
+		queue11.pushBack(1);
+	}
+	statistics = QueueBufferCache::statistics();
+	AGREGATE_TEST_RESULT(testResult, statistics.m_hits == 0 && statistics.m_cached == 0 && statistics.m_freed == 1);
+	QueueBufferCache::setMaxBlocksPerClass(previousMaxBlocks);
+
+	return testResult;
+}
+
+bool testReductions()
+{
+	bool testResult = true;
+
+	Queue<int> queue12;
+	AGREGATE_TEST_RESULT(testResult, sum(queue12) == 0 && minElement(queue12) == -1 && maxElement(queue12) == -1);
+	for (int i = 0; i < 100; i++) {
+		queue12.pushBack(i % 10 == 7 ? -i : i);
+	}
+	for (int i = 0; i < 30; i++) {
+		queue12.popFront();
+		queue12.pushBack(i == 12 ? 500 : i);
+	}
+	/* the queue holds 30..99 with every seventh of ten negated, followed by 0..29 with 500 in place of 12 */
+	int expectedSum = 0;
+	for (int data : queue12) {
+		expectedSum += data;
+	}
+	AGREGATE_TEST_RESULT(testResult, sum(queue12) == expectedSum);
+	AGREGATE_TEST_RESULT(testResult, reduce(queue12, 0LL, [](long long total, int data) { return total + data; })
+		== expectedSum);
+	AGREGATE_TEST_RESULT(testResult, countIf(queue12, isEven) == 50);
+	AGREGATE_TEST_RESULT(testResult, queue12[minElement(queue12)] == -97 && minElement(queue12) == 67);
+	AGREGATE_TEST_RESULT(testResult, queue12[maxElement(queue12)] == 500 && maxElement(queue12) == 82);
+
+	Queue<double> queue13;
+	queue13.pushBack(0.5);
+	queue13.pushBack(-1.5);
+	queue13.pushBack(-1.5);
+	AGREGATE_TEST_RESULT(testResult, sum(queue13) == -2.5 && minElement(queue13) == 1 && maxElement(queue13) == 0);
+
+	/* ties go to the first element, also for types with only operator< */
+	Queue<HealthPoints> queue14;
+	for (int i = 0; i < 6; i++) {
+		queue14.pushBack(HealthPoints(100));
+	}
+	queue14[2] -= 60;
+	queue14[4] -= 60;
+	queue14[5] -= 10;
+	AGREGATE_TEST_RESULT(testResult, minElement(queue14) == 2 && maxElement(queue14) == 0);
+	AGREGATE_TEST_RESULT(testResult, countIf(queue14, [](const HealthPoints& hp) { return hp < 50; }) == 2);
+
+	return testResult;
+}
+
+template <class T>
+static bool holdsInOrder(const Queue<T>& queue, const Queue<T>& expected)
+{
+	if (queue.size() != expected.size()) {
+		return false;
+	}
+	for (int i = 0; i < queue.size(); i++) {
+		if (!(queue[i] == expected[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool testSpliceAndSplit()
+{
+	bool testResult = true;
+
+	Queue<int> queue15;
+	Queue<int> queue16;
+	Queue<int> expected;
+	for (int i = 0; i < 5; i++) {
+		queue15.pushBack(-1);
+	}
+	for (int i = 0; i < 30; i++) {
+		queue15.pushBack(i);
+		if (i < 5) {
+			queue15.popFront();
+		}
+		expected.pushBack(i);
+	}
+	/* an empty queue takes the array of the other */
+	queue16.splice(queue15);
+	AGREGATE_TEST_RESULT(testResult, queue15.size() == 0 && holdsInOrder(queue16, expected));
+
+	/* a short queue is moved in front of the elements of the longer one, which has room for it */
+	Queue<int> queue17;
+	Queue<int> shortExpected;
+	for (int i = -3; i < 0; i++) {
+		queue17.pushBack(i);
+		shortExpected.pushBack(i);
+	}
+	queue17.splice(queue16);
+	shortExpected.splice(expected);
+	AGREGATE_TEST_RESULT(testResult, queue16.size() == 0 && holdsInOrder(queue17, shortExpected));
+
+	/* the longer queue grows once and takes the elements of the shorter one */
+	Queue<int> queue18;
+	for (int i = 100; i < 110; i++) {
+		queue18.pushBack(i);
+	}
+	queue17.splice(queue18);
+	AGREGATE_TEST_RESULT(testResult, queue18.size() == 0 && queue17.size() == 43 && queue17[33] == 100);
+	AGREGATE_TEST_RESULT(testResult, queue17[0] == -3 && queue17[42] == 109);
+	queue17.splice(queue17);
+	AGREGATE_TEST_RESULT(testResult, queue17.size() == 43);
+
+	Queue<int> tail = queue17.splitAt(40);
+	AGREGATE_TEST_RESULT(testResult, queue17.size() == 40 && tail.size() == 3 && tail.front() == 107);
+	Queue<int> longTail = queue17.splitAt(3);
+	AGREGATE_TEST_RESULT(testResult, queue17.size() == 3 && queue17[2] == -1);
+	AGREGATE_TEST_RESULT(testResult, longTail.size() == 37 && longTail.front() == 0 && longTail[36] == 106 && longTail[29] == 29);
+	AGREGATE_TEST_RESULT(testResult, queue17.splitAt(3).size() == 0 && queue17.splitAt(0).size() == 3);
+	AGREGATE_TEST_RESULT(testResult, queue17.size() == 0);
+
+	bool exceptionThrown = false;
+	try {
+		longTail.splitAt(38);
+	}
+	catch (Queue<int>::OutOfRange& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown && longTail.size() == 37);
+
+	Queue<std::string> words;
+	Queue<std::string> moreWords;
+	for (int i = 0; i < 20; i++) {
+		(i < 5 ? words : moreWords).pushBack(std::string(i + 20, 'a' + i));
+	}
+	words.splice(moreWords);
+	Queue<std::string> lastWords = words.splitAt(15);
+	AGREGATE_TEST_RESULT(testResult, words.size() == 15 && words[14] == std::string(34, 'o'));
+	AGREGATE_TEST_RESULT(testResult, lastWords.size() == 5 && lastWords.front() == std::string(35, 'p'));
+
+	/* the largest capacity, beyond the last power of two times the initial size, is reserved or refused */
+	Queue<char> letters;
+	for (int i = 0; i < 26; i++) {
+		letters.pushBack(static_cast<char>('a' + i));
+		if (i < 10) {
+			letters.popFront();
+		}
+	}
+	bool reserved = true;
+	try {
+		letters.reserve(std::numeric_limits<int>::max());
+	}
+	catch (std::bad_alloc& e) {
+		reserved = false;
+	}
+	if (reserved) {
+		letters.pushBack('!');
+	}
+	AGREGATE_TEST_RESULT(testResult, letters.size() == (reserved ? 17 : 16) && letters.front() == 'k' && letters[15] == 'z');
+
+	return testResult;
+}
+
+
+template <class T, class Compare>
+static bool isSortedBy(const Queue<T>& queue, const Compare& compare)
+{
+	for (int i = 1; i < queue.size(); i++) {
+		if (compare(queue[i], queue[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool testSortAndMerge()
+{
+	bool testResult = true;
+	auto ascending = [](long long data1, long long data2) { return data1 < data2; };
+
+	/* short and long queues, wrapped around the end of their arrays, sorted by comparison and by radix */
+	for (int size : { 0, 1, 50, 3000 }) {
+		Queue<long long> queue19;
+		unsigned int random = 12345;
+		long long expectedSum = 0;
+		for (int i = 0; i < size + size / 3; i++) {
+			random = random * 1103515245 + 12345;
+			long long data = (static_cast<long long>(random) << 20) * (i % 3 == 0 ? -1 : 1);
+			queue19.pushBack(data);
+			expectedSum += data;
+			if (i < size / 3) {
+				expectedSum -= queue19.front();
+				queue19.popFront();
+			}
+		}
+		Queue<long long> queue20 = queue19;
+		sort(queue19);
+		AGREGATE_TEST_RESULT(testResult, queue19.size() == size && sum(queue19) == expectedSum);
+		AGREGATE_TEST_RESULT(testResult, isSortedBy(queue19, ascending));
+		sort(queue20, [](long long data1, long long data2) { return data1 > data2; });
+		AGREGATE_TEST_RESULT(testResult, queue20.size() == size && sum(queue20) == expectedSum);
+		AGREGATE_TEST_RESULT(testResult, isSortedBy(queue20, [](long long data1, long long data2) { return data1 > data2; }));
+		queue19.pushBack(0);
+		AGREGATE_TEST_RESULT(testResult, queue19.size() == size + 1 && queue19[size] == 0);
+	}
+
+	/* a full array whose elements wrap around its end, of a type that is not moved with memcpy */
+	auto makeFullWrapped = []() {
+		Queue<std::vector<int>> vectors;
+		for (int i = 0; i < 13; i++) {
+			vectors.pushBack(std::vector<int>(3, (i * 7) % 13));
+			if (i < 3) {
+				vectors.popFront();
+			}
+		}
+		return vectors;
+	};
+	auto byFirstValue = [](const std::vector<int>& data1, const std::vector<int>& data2) { return data1[0] < data2[0]; };
+	auto allFull = [](const Queue<std::vector<int>>& vectors) {
+		return countIf(vectors, [](const std::vector<int>& data) { return data.size() == 3; }) == vectors.size();
+	};
+	Queue<std::vector<int>> vectors1 = makeFullWrapped();
+	Queue<std::vector<int>> vectors2 = makeFullWrapped();
+	sort(vectors1, byFirstValue);
+	radixSort(vectors2, [](const std::vector<int>& data) { return data[0]; });
+	AGREGATE_TEST_RESULT(testResult, vectors1.size() == 10 && allFull(vectors1) && isSortedBy(vectors1, byFirstValue));
+	AGREGATE_TEST_RESULT(testResult, vectors2.size() == 10 && allFull(vectors2) && isSortedBy(vectors2, byFirstValue));
+	AGREGATE_TEST_RESULT(testResult, vectors1.front()[0] == 2 && vectors2[9][0] == 12);
+
+	/* the radix sort and stableSort keep equal keys in order */
+	Queue<std::pair<int, int>> pairs;
+	Queue<std::pair<int, int>> morePairs;
+	for (int i = 0; i < 1000; i++) {
+		pairs.pushBack(std::pair<int, int>((i * 37) % 101 - 50, i));
+		morePairs.pushBack(pairs[i]);
+	}
+	radixSort(pairs, [](const std::pair<int, int>& data) { return data.first; });
+	stableSort(morePairs, [](const std::pair<int, int>& data1, const std::pair<int, int>& data2) {
+		return data1.first < data2.first;
+	});
+	AGREGATE_TEST_RESULT(testResult, holdsInOrder(pairs, morePairs) && pairs.front().first == -50);
+	AGREGATE_TEST_RESULT(testResult, isSortedBy(pairs, [](const std::pair<int, int>& data1, const std::pair<int, int>& data2) {
+		return data1.first < data2.first || (data1.first == data2.first && data1.second < data2.second);
+	}));
+
+	Queue<unsigned char> bytes;
+	for (int i = 0; i < 600; i++) {
+		bytes.pushBack(static_cast<unsigned char>(255 - i % 256));
+	}
+	stableSort(bytes);
+	AGREGATE_TEST_RESULT(testResult, bytes[1] == 0 && bytes[2] == 1 && bytes[3] == 1 && bytes[599] == 255);
+
+	/* HealthPoints are radix sorted by current hp */
+	Queue<HealthPoints> queue21;
+	for (int i = 0; i < 500; i++) {
+		queue21.pushBack(HealthPoints(1000));
+		queue21[i] -= (i * 7919) % 1000;
+	}
+	HealthPoints lowest = queue21[minElement(queue21)];
+	sort(queue21);
+	AGREGATE_TEST_RESULT(testResult, isSortedBy(queue21, [](const HealthPoints& hp1, const HealthPoints& hp2) {
+		return hp1 < hp2;
+	}));
+	AGREGATE_TEST_RESULT(testResult, queue21.size() == 500 && queue21.front() == lowest);
+
+	/* merge takes the elements of earlier queues first on ties, and empties the queues */
+	Queue<Queue<std::pair<int, int>>> sortedQueues;
+	for (int source = 0; source < 5; source++) {
+		Queue<std::pair<int, int>> sortedQueue;
+		for (int i = 0; i < source * 10; i++) {
+			sortedQueue.pushBack(std::pair<int, int>(i * source / 3, source));
+		}
+		sortedQueues.pushBack(sortedQueue);
+	}
+	auto byFirst = [](const std::pair<int, int>& data1, const std::pair<int, int>& data2) {
+		return data1.first < data2.first;
+	};
+	Queue<std::pair<int, int>> merged = merge(sortedQueues, byFirst);
+	AGREGATE_TEST_RESULT(testResult, merged.size() == 100 && isSortedBy(merged, byFirst));
+	AGREGATE_TEST_RESULT(testResult, isSortedBy(merged, [](const std::pair<int, int>& data1, const std::pair<int, int>& data2) {
+		return data1.first < data2.first || (data1.first == data2.first && data1.second < data2.second);
+	}));
+	AGREGATE_TEST_RESULT(testResult, merged.front().second == 1 && merged[merged.size() - 1].first == 52);
+	AGREGATE_TEST_RESULT(testResult, sortedQueues.size() == 5 && sortedQueues[4].size() == 0);
+
+	Queue<Queue<int>> noQueues;
+	AGREGATE_TEST_RESULT(testResult, merge(noQueues).size() == 0);
+
+	return testResult;
+}
+
 }
@@ -0,0 +1,404 @@
+#ifndef QUEUE_TRACE_H
+#define QUEUE_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+
+/* Whether Queue and HealthPoints record their events, 0 compiles the QUEUE_TRACE hooks out */
+#ifndef QUEUE_TRACE_ENABLED
+#define QUEUE_TRACE_ENABLED 0
+#endif
+
+/* How many events each thread's buffer holds until it is flushed, events beyond it are dropped */
+#ifndef QUEUE_TRACE_BUFFER_EVENTS
+#define QUEUE_TRACE_BUFFER_EVENTS (1 << 16)
+#endif
+
+#if QUEUE_TRACE_ENABLED
+#define QUEUE_TRACE(type, object, value) QueueTrace::record(QueueTrace::type, (object), (value))
+#define QUEUE_TRACE_THRESHOLD(object, previousHP, currentHP) \
+    QueueTrace::recordThresholdCrossing((object), (previousHP), (currentHP))
+#else
+#define QUEUE_TRACE(type, object, value) ((void)0)
+#define QUEUE_TRACE_THRESHOLD(object, previousHP, currentHP) ((void)0)
+#endif
+
+
+/*
+ * QueueTrace - Recorder of the hot path events of Queue and HealthPoints, for offline profiling.
+ * Every thread records to a buffer of its own, with no lock and no shared write: the thread is the only writer
+ * of the events and of the count of written events, and flush is the only writer of the count of flushed ones.
+ * A full buffer drops new events, and counts them, until it is flushed. The buffer of a thread that exits is kept
+ * until its events are flushed, and is then reused by a new thread.
+ *
+ * Pushes and pops are frequent, so only one of every sampleRate() of them is recorded by each thread. The other
+ * events are rare and always recorded. flush writes the events in the Chrome trace JSON format, which
+ * chrome://tracing and Perfetto open: the size of every queue as a counter, grows and shrinks of its array and
+ * hp threshold crossings as instant events, and filters as durations.
+ *
+ * Queue and HealthPoints record through the QUEUE_TRACE macros, which are empty unless QUEUE_TRACE_ENABLED is
+ * defined as 1 - the same value in every file of the program.
+*/
+class QueueTrace {
+
+public:
+
+    /* The kinds of events, the value of an event is given for each */
+    enum Type {
+        PUSH,           /* size of the queue after the push */
+        POP,            /* size of the queue after the pop */
+        GROW,           /* new size of the array */
+        SHRINK,         /* new size of the array */
+        FILTER_BEGIN,   /* size of the filtered queue */
+        FILTER_END,     /* size of the result */
+        HP_THRESHOLD    /* current hp after crossing the threshold */
+    };
+
+    /*
+     * Event - a recorded event. m_time is in nanoseconds of std::chrono::steady_clock.
+    */
+    struct Event {
+        std::int64_t m_time;
+        const void* m_object;
+        long long m_value;
+        Type m_type;
+    };
+
+    /*
+     * record - records an event to the calling thread's buffer. PUSH and POP are sampled.
+     * If the buffer of the thread cannot be allocated the event is dropped.
+     *
+     * @param type - the kind of the event.
+     * @param object - the queue or HealthPoints the event happened to.
+     * @param value - the value of the event, see Type.
+    */
+    static void record(Type type, const void* object, long long value) noexcept;
+
+    /*
+     * recordThresholdCrossing - records an HP_THRESHOLD event if the hp went from at least healthPointsThreshold()
+     * to below it, or back.
+    */
+    static void recordThresholdCrossing(const void* healthPoints, int previousHP, int currentHP) noexcept;
+
+    /*
+     * flush - writes the events recorded since the last flush, by every thread, and empties the buffers.
+     * The events of each thread are in order, and a trace viewer sorts the threads together by time.
+     *
+     * @param stream - the stream to write a Chrome trace JSON object to.
+     * @return
+     * Returns the number of events written.
+     * @exception
+     * A random exception might be thrown by the stream, in which case the events are lost.
+    */
+    static long long flush(std::ostream& stream);
+
+    /*
+     * setSampleRate - records one of every sampleRate pushes and pops of each thread.
+     *
+     * @param sampleRate - the rate, 1 records them all and values below 1 are taken as 1.
+    */
+    static void setSampleRate(int sampleRate) noexcept;
+
+    static int sampleRate() noexcept;
+
+    /*
+     * setHealthPointsThreshold - sets the hp whose crossing is recorded, 1 by default, so that reaching 0 hp
+     * and recovering from it are recorded.
+    */
+    static void setHealthPointsThreshold(int threshold) noexcept;
+
+    static int healthPointsThreshold() noexcept;
+
+    /*
+     * droppedEvents - the number of events dropped by full buffers since the program started.
+    */
+    static long long droppedEvents() noexcept;
+
+private:
+
+    static const std::uint64_t BUFFER_EVENTS = QUEUE_TRACE_BUFFER_EVENTS;
+
+    /*
+     * ThreadBuffer - the events of a thread, in a ring of BUFFER_EVENTS. The buffers are never freed, and are
+     * linked in a list that only grows, so flush reads them without stopping the threads.
+    */
+    struct ThreadBuffer {
+        Event m_events[BUFFER_EVENTS];
+        std::atomic<std::uint64_t> m_written{0};
+        std::atomic<std::uint64_t> m_flushed{0};
+        std::atomic<long long> m_dropped{0};
+        std::atomic<bool> m_owned{true};
+        int m_sampleCount = 0;
+        int m_threadNumber = 0;
+        ThreadBuffer* m_next = nullptr;
+    };
+
+    /*
+     * ThreadState - the buffer of a thread. Trivially destructible, so reaching it takes no check of
+     * thread_local initialization, and it stays usable after the buffer was given up.
+    */
+    struct ThreadState {
+        ThreadBuffer* m_buffer = nullptr;
+        bool m_released = false;
+    };
+
+    /*
+     * Releaser - gives the buffer of a thread up for reuse when the thread exits. Events recorded after that,
+     * by the destructors of thread_local objects, are dropped.
+    */
+    struct Releaser {
+        ~Releaser();
+    };
+
+    /*
+     * threadState - the state of the calling thread.
+    */
+    static ThreadState& threadState() noexcept;
+
+    /*
+     * threadBuffer - the buffer of the calling thread, taken on its first event. nullptr if it cannot be allocated.
+    */
+    static ThreadBuffer* threadBuffer() noexcept;
+
+    /*
+     * acquireBuffer - a buffer given up by an exited thread, or a new one added to the list.
+    */
+    static ThreadBuffer* acquireBuffer() noexcept;
+
+    static std::atomic<ThreadBuffer*>& buffers() noexcept;
+    static std::atomic<int>& sampleRateSetting() noexcept;
+    static std::atomic<int>& thresholdSetting() noexcept;
+    static std::mutex& flushMutex() noexcept;
+
+    /* How many bytes of events flush formats before writing them to the stream */
+    static const std::size_t FLUSH_BYTES = 1 << 16;
+
+    /*
+     * writeEvent - appends an event as a Chrome trace event object. Formatted by hand, as formatting the numbers
+     * with the stream, or with snprintf, takes most of the time of a flush.
+    */
+    static void writeEvent(std::string& text, const Event& event, int threadNumber);
+};
+
+
+inline void QueueTrace::record(Type type, const void* object, long long value) noexcept{
+    ThreadBuffer* buffer = threadBuffer();
+    if(buffer == nullptr){
+        return;
+    }
+    if(type == PUSH || type == POP){
+        if(++buffer->m_sampleCount < sampleRateSetting().load(std::memory_order_relaxed)){
+            return;
+        }
+        buffer->m_sampleCount = 0;
+    }
+
+    std::uint64_t written = buffer->m_written.load(std::memory_order_relaxed);
+    if(written - buffer->m_flushed.load(std::memory_order_acquire) == BUFFER_EVENTS){
+        buffer->m_dropped.store(buffer->m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    Event& event = buffer->m_events[written % BUFFER_EVENTS];
+    event.m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    event.m_object = object;
+    event.m_value = value;
+    event.m_type = type;
+    /* Publishes the event to flush */
+    buffer->m_written.store(written + 1, std::memory_order_release);
+}
+
+inline void QueueTrace::recordThresholdCrossing(const void* healthPoints, int previousHP, int currentHP) noexcept{
+    int threshold = thresholdSetting().load(std::memory_order_relaxed);
+    if((previousHP < threshold) != (currentHP < threshold)){
+        record(HP_THRESHOLD, healthPoints, currentHP);
+    }
+}
+
+inline long long QueueTrace::flush(std::ostream& stream){
+    std::lock_guard<std::mutex> lock(flushMutex());
+    long long events = 0;
+    long long dropped = 0;
+    std::string text("{\"traceEvents\":[");
+    text.reserve(FLUSH_BYTES + 256);
+    for(ThreadBuffer* buffer = buffers().load(std::memory_order_acquire) ; buffer != nullptr ; buffer = buffer->m_next){
+        std::uint64_t flushed = buffer->m_flushed.load(std::memory_order_relaxed);
+        std::uint64_t written = buffer->m_written.load(std::memory_order_acquire);
+        for( ; flushed != written ; flushed++){
+            text.append(events == 0 ? "\n" : ",\n");
+            writeEvent(text, buffer->m_events[flushed % BUFFER_EVENTS], buffer->m_threadNumber);
+            events++;
+            if(text.size() >= FLUSH_BYTES){
+                stream.write(text.data(), text.size());
+                text.clear();
+            }
+        }
+        /* Gives the space of the written events back to the thread */
+        buffer->m_flushed.store(written, std::memory_order_release);
+        dropped += buffer->m_dropped.load(std::memory_order_relaxed);
+    }
+    stream.write(text.data(), text.size());
+    stream << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+    return events;
+}
+
+inline void QueueTrace::setSampleRate(int sampleRate) noexcept{
+    sampleRateSetting().store(sampleRate < 1 ? 1 : sampleRate, std::memory_order_relaxed);
+}
+
+inline int QueueTrace::sampleRate() noexcept{
+    return sampleRateSetting().load(std::memory_order_relaxed);
+}
+
+inline void QueueTrace::setHealthPointsThreshold(int threshold) noexcept{
+    thresholdSetting().store(threshold, std::memory_order_relaxed);
+}
+
+inline int QueueTrace::healthPointsThreshold() noexcept{
+    return thresholdSetting().load(std::memory_order_relaxed);
+}
+
+inline long long QueueTrace::droppedEvents() noexcept{
+    long long dropped = 0;
+    for(ThreadBuffer* buffer = buffers().load(std::memory_order_acquire) ; buffer != nullptr ; buffer = buffer->m_next){
+        dropped += buffer->m_dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+inline QueueTrace::Releaser::~Releaser(){
+    ThreadState& state = threadState();
+    state.m_buffer->m_owned.store(false, std::memory_order_release);
+    state.m_buffer = nullptr;
+    state.m_released = true;
+}
+
+inline QueueTrace::ThreadState& QueueTrace::threadState() noexcept{
+    static thread_local ThreadState t_state;
+    return t_state;
+}
+
+inline QueueTrace::ThreadBuffer* QueueTrace::threadBuffer() noexcept{
+    ThreadState& state = threadState();
+    if(state.m_buffer == nullptr && !state.m_released){
+        state.m_buffer = acquireBuffer();
+        if(state.m_buffer != nullptr){
+            /* Constructed once, with the first buffer of the thread, so it is destroyed when the thread exits */
+            static thread_local Releaser t_releaser;
+        }
+    }
+    return state.m_buffer;
+}
+
+inline QueueTrace::ThreadBuffer* QueueTrace::acquireBuffer() noexcept{
+    std::atomic<ThreadBuffer*>& head = buffers();
+    for(ThreadBuffer* buffer = head.load(std::memory_order_acquire) ; buffer != nullptr ; buffer = buffer->m_next){
+        bool owned = false;
+        if(!buffer->m_owned.load(std::memory_order_relaxed)
+            && buffer->m_owned.compare_exchange_strong(owned, true, std::memory_order_acquire)){
+            buffer->m_sampleCount = 0;
+            return buffer;
+        }
+    }
+
+    ThreadBuffer* buffer = new (std::nothrow) ThreadBuffer();
+    if(buffer == nullptr){
+        return nullptr;
+    }
+    ThreadBuffer* first = head.load(std::memory_order_relaxed);
+    do{
+        buffer->m_next = first;
+        buffer->m_threadNumber = first == nullptr ? 1 : first->m_threadNumber + 1;
+    } while(!head.compare_exchange_weak(first, buffer, std::memory_order_release, std::memory_order_relaxed));
+    return buffer;
+}
+
+inline std::atomic<QueueTrace::ThreadBuffer*>& QueueTrace::buffers() noexcept{
+    static std::atomic<ThreadBuffer*> s_buffers{nullptr};
+    return s_buffers;
+}
+
+inline std::atomic<int>& QueueTrace::sampleRateSetting() noexcept{
+    static std::atomic<int> s_sampleRate{1};
+    return s_sampleRate;
+}
+
+inline std::atomic<int>& QueueTrace::thresholdSetting() noexcept{
+    static std::atomic<int> s_threshold{1};
+    return s_threshold;
+}
+
+inline std::mutex& QueueTrace::flushMutex() noexcept{
+    static std::mutex s_flushMutex;
+    return s_flushMutex;
+}
+
+inline void QueueTrace::writeEvent(std::string& text, const Event& event, int threadNumber){
+    static const char* const NAMES[] = { "push", "pop", "grow", "shrink", "filter", "filter", "hp threshold" };
+    /* Longer than any event, which is appended to text in one step */
+    char line[256];
+    std::size_t length = 0;
+    auto append = [&line, &length](const char* literal) {
+        for( ; *literal != '\0' ; literal++){
+            line[length++] = *literal;
+        }
+    };
+    auto appendNumber = [&line, &length](unsigned long long value, int base) {
+        char digits[24];
+        int count = 0;
+        do{
+            digits[count++] = "0123456789abcdef"[value % base];
+            value /= base;
+        } while(value != 0);
+        while(count > 0){
+            line[length++] = digits[--count];
+        }
+    };
+
+    append("{\"pid\":1,\"tid\":");
+    appendNumber(threadNumber, 10);
+    /* Chrome trace times are in microseconds */
+    append(",\"ts\":");
+    appendNumber(event.m_time / 1000, 10);
+    line[length++] = '.';
+    line[length++] = static_cast<char>('0' + event.m_time / 100 % 10);
+    line[length++] = static_cast<char>('0' + event.m_time / 10 % 10);
+    line[length++] = static_cast<char>('0' + event.m_time % 10);
+    switch(event.m_type){
+        case PUSH:
+        case POP:
+            /* Counters are shown per name, so every queue gets a size track of its own */
+            append(",\"ph\":\"C\",\"name\":\"queue 0x");
+            appendNumber(reinterpret_cast<std::uintptr_t>(event.m_object), 16);
+            append("\",\"args\":{\"size\":");
+            break;
+        case FILTER_BEGIN:
+        case FILTER_END:
+            append(event.m_type == FILTER_BEGIN ? ",\"ph\":\"B\"" : ",\"ph\":\"E\"");
+            append(",\"name\":\"filter\",\"args\":{\"queue\":\"0x");
+            appendNumber(reinterpret_cast<std::uintptr_t>(event.m_object), 16);
+            append("\",\"size\":");
+            break;
+        default:
+            append(",\"ph\":\"i\",\"s\":\"t\",\"name\":\"");
+            append(NAMES[event.m_type]);
+            append("\",\"args\":{\"object\":\"0x");
+            appendNumber(reinterpret_cast<std::uintptr_t>(event.m_object), 16);
+            append("\",\"value\":");
+            break;
+    }
+    if(event.m_value < 0){
+        line[length++] = '-';
+    }
+    appendNumber(event.m_value < 0 ? 0ULL - static_cast<unsigned long long>(event.m_value)
+                                   : static_cast<unsigned long long>(event.m_value), 10);
+    append("}}");
+    text.append(line, length);
+}
+
+#endif //QUEUE_TRACE_H
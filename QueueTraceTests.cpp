@@ -0,0 +1,139 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "AtomicHealthPoints.h"
+#include "HealthPoints.h"
+#include "HealthPointsLoader.h"
+#include "Queue.h"
+#include "QueueTrace.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace QueueTraceTests {
+
+static int countOf(const std::string& text, const std::string& pattern)
+{
+	int count = 0;
+	for (std::size_t place = text.find(pattern); place != std::string::npos; place = text.find(pattern, place + 1)) {
+		count++;
+	}
+	return count;
+}
+
+static std::string flushed(long long& events)
+{
+	std::ostringstream stream;
+	events = QueueTrace::flush(stream);
+	return stream.str();
+}
+
+bool testRecordAndFlush()
+{
+	bool testResult = true;
+	long long events = 0;
+	/* events recorded by other tests, with the hooks compiled in */
+	flushed(events);
+
+	int object = 0;
+	QueueTrace::record(QueueTrace::PUSH, &object, 1);
+	QueueTrace::record(QueueTrace::GROW, &object, 20);
+	QueueTrace::record(QueueTrace::FILTER_BEGIN, &object, 1);
+	QueueTrace::record(QueueTrace::FILTER_END, &object, 0);
+	QueueTrace::recordThresholdCrossing(&object, 5, 3);
+	QueueTrace::recordThresholdCrossing(&object, 1, 0);
+	QueueTrace::recordThresholdCrossing(&object, 0, 0);
+	std::string trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 5 && countOf(trace, "\"ph\"") == 5);
+	AGREGATE_TEST_RESULT(testResult, trace.find("{\"traceEvents\":[") == 0 && countOf(trace, "\"ph\":\"C\"") == 1);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"grow\"") == 1 && countOf(trace, "\"name\":\"filter\"") == 2);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"hp threshold\"") == 1 && countOf(trace, "\"value\":0}") == 1);
+
+	/* a flushed event is not written again */
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 0 && countOf(trace, "\"ph\"") == 0);
+
+	/* a full buffer drops events until it is flushed */
+	long long droppedBefore = QueueTrace::droppedEvents();
+	for (int i = 0; i < QUEUE_TRACE_BUFFER_EVENTS + 10; i++) {
+		QueueTrace::record(QueueTrace::SHRINK, &object, i);
+	}
+	AGREGATE_TEST_RESULT(testResult, QueueTrace::droppedEvents() == droppedBefore + 10);
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == QUEUE_TRACE_BUFFER_EVENTS);
+	QueueTrace::record(QueueTrace::SHRINK, &object, 0);
+	flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 1);
+
+	return testResult;
+}
+
+bool testSamplingAndThreads()
+{
+	bool testResult = true;
+	long long events = 0;
+	flushed(events);
+
+	/* only pushes and pops are sampled */
+	int object = 0;
+	QueueTrace::setSampleRate(10);
+	for (int i = 0; i < 1000; i++) {
+		QueueTrace::record(i % 2 == 0 ? QueueTrace::PUSH : QueueTrace::POP, &object, i);
+	}
+	QueueTrace::record(QueueTrace::GROW, &object, 100);
+	QueueTrace::setSampleRate(0);
+	AGREGATE_TEST_RESULT(testResult, QueueTrace::sampleRate() == 1);
+	std::string trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 101 && countOf(trace, "\"name\":\"grow\"") == 1);
+
+	/* the events of a thread that exited are flushed, and a new thread takes its buffer */
+	for (int round = 0; round < 3; round++) {
+		std::thread producer([&object]() {
+			for (int i = 0; i < 50; i++) {
+				QueueTrace::record(QueueTrace::PUSH, &object, i);
+			}
+		});
+		producer.join();
+	}
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 150 && countOf(trace, "\"args\":{\"size\":49}") == 3);
+
+#if QUEUE_TRACE_ENABLED
+	/* Queue and HealthPoints record through the hooks */
+	QueueTrace::setHealthPointsThreshold(50);
+	Queue<HealthPoints> queue;
+	for (int i = 0; i < 11; i++) {
+		queue.pushBack(HealthPoints(100));
+	}
+	queue[0] -= 60;
+	queue[0] += 20;
+	Queue<HealthPoints> weak = filter(queue, [](const HealthPoints& healthPoints) { return healthPoints < 100; });
+	while (queue.size() > 0) {
+		queue.popFront();
+	}
+	QueueTrace::setHealthPointsThreshold(1);
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"hp threshold\"") == 2 && weak.size() == 1);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"grow\"") >= 1 && countOf(trace, "\"name\":\"shrink\"") >= 1);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"filter\"") == 2 && countOf(trace, "\"args\":{\"size\":0}") >= 1);
+
+	/* copies of a state, as made by AtomicHealthPoints, are not crossings */
+	AtomicHealthPoints atomicHealthPoints(100);
+	atomicHealthPoints -= 100;
+	std::ostringstream printed;
+	printed << atomicHealthPoints << atomicHealthPoints.snapshot();
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, events == 0 && printed.str() == "0(100)0(100)");
+
+	/* nor are loaded records */
+	std::istringstream records("0(100) 30(40)");
+	Queue<HealthPoints> loaded;
+	HealthPointsLoader::loadStream(records, loaded);
+	trace = flushed(events);
+	AGREGATE_TEST_RESULT(testResult, countOf(trace, "\"name\":\"hp threshold\"") == 0 && loaded.size() == 2);
+#endif
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,298 @@
+#ifndef SHARDED_QUEUE_H
+#define SHARDED_QUEUE_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "Queue.h"
+
+
+/*
+ * ShardedQueue - Thread safe queue made of one Queue<T> shard per core.
+ * Producers push to their own shard, so concurrent producers do not share a lock or a cache line.
+ * Consumers drain the shards by round robin, or by picking the longer of two random shards.
+ *
+ * Ordering:
+ * PER_PRODUCER_FIFO - every thread always pushes to the same shard, so the elements of a single
+ *                     producer are popped in the order they were pushed.
+ * RELAXED_FIFO      - a thread pushes to the shard of the core it runs on, and moves on to the next shard
+ *                     if that one is locked. Elements of a single producer may be popped out of order.
+*/
+template <class T>
+class ShardedQueue {
+
+public:
+
+    enum class Ordering { PER_PRODUCER_FIFO, RELAXED_FIFO };
+
+    enum class Selection { ROUND_ROBIN, POWER_OF_TWO_CHOICES };
+
+    /*
+     * C'tor for ShardedQueue class.
+     *
+     * @param numberOfShards - number of shards, the hardware concurrency by default.
+     * @param ordering - ordering guarantee of the queue.
+     * @param selection - how consumers pick the shard to pop from.
+     * @return
+     * A new instance of ShardedQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit ShardedQueue(int numberOfShards = defaultNumberOfShards(), Ordering ordering = Ordering::PER_PRODUCER_FIFO,
+                          Selection selection = Selection::ROUND_ROBIN);
+
+    /*
+     * D'tor for ShardedQueue class.
+    */
+    ~ShardedQueue();
+
+    /*
+     * The shards are shared between threads by address, so copying is not allowed.
+    */
+    ShardedQueue(const ShardedQueue& queue) = delete;
+    ShardedQueue& operator=(const ShardedQueue& otherQueue) = delete;
+
+    /*
+     * pushBack - Inserts a new member at the end of the calling thread's shard.
+     *
+     * @param argumentToAdd - new member to add.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown.
+    */
+    void pushBack(const T& argumentToAdd);
+
+    /*
+     * popFrontInto - Moves the first element of a non empty shard into destination and removes it.
+     *
+     * @param destination - receives the element.
+     * @return
+     * Returns true if an element was removed, false if every shard was empty.
+    */
+    bool popFrontInto(T& destination);
+
+    /*
+     * tryPopFront - Removes the first element of a non empty shard and returns it.
+     *
+     * @return
+     * Returns the removed element, or an empty optional if every shard was empty.
+    */
+    std::optional<T> tryPopFront();
+
+    /*
+     * size - approximate number of elements, read without taking any lock.
+     *
+     * @return
+     * Returns the number of elements, possibly missing pushes and pops that are in progress.
+    */
+    int size() const;
+
+    /*
+     * exactSize - exact number of elements, taking the lock of every shard at once.
+     *
+     * @return
+     * Returns the number of elements.
+    */
+    int exactSize() const;
+
+    /*
+     * numberOfShards - the number of shards.
+    */
+    int numberOfShards() const;
+
+    /*
+     * defaultNumberOfShards - the hardware concurrency, or 1 if it is unknown.
+    */
+    static int defaultNumberOfShards();
+
+private:
+
+    /*
+     * Shard - a Queue<T> with its lock, on cache lines of its own.
+    */
+    struct alignas(64) Shard {
+        mutable std::mutex m_mutex;
+        Queue<T> m_data;
+        std::atomic<int> m_size{0};
+    };
+
+    Shard* m_shards;
+    int m_numberOfShards;
+    Ordering m_ordering;
+    Selection m_selection;
+    alignas(64) std::atomic<unsigned> m_nextShard;
+
+    /*
+     * producerShard - the shard the calling thread pushes to first.
+    */
+    int producerShard() const;
+
+    /*
+     * popFromShard - pops the first element of the shard if it is not empty.
+    */
+    static bool popFromShard(Shard& shard, T& destination);
+
+    /*
+     * randomShard - a shard chosen by a per thread pseudo random generator.
+    */
+    int randomShard() const;
+};
+
+
+/* ------------------------------------ Public Functions of ShardedQueue Class ------------------------------------*/
+
+template <class T>
+ShardedQueue<T>::ShardedQueue(int numberOfShards, Ordering ordering, Selection selection) : m_shards(nullptr),
+    m_numberOfShards(numberOfShards > 0 ? numberOfShards : 1), m_ordering(ordering), m_selection(selection),
+    m_nextShard(0) {
+    m_shards = new Shard[m_numberOfShards];
+}
+
+template <class T>
+ShardedQueue<T>::~ShardedQueue(){
+    delete[] m_shards;
+}
+
+template <class T>
+void ShardedQueue<T>::pushBack(const T& argumentToAdd){
+    int shardIndex = producerShard();
+    if(m_ordering == Ordering::RELAXED_FIFO){
+        for(int i = 0 ; i < m_numberOfShards ; i++){
+            Shard& shard = m_shards[(shardIndex + i) % m_numberOfShards];
+            std::unique_lock<std::mutex> lock(shard.m_mutex, std::try_to_lock);
+            if(lock.owns_lock()){
+                shard.m_data.pushBack(argumentToAdd);
+                shard.m_size.store(shard.m_data.size(), std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    Shard& shard = m_shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.m_data.pushBack(argumentToAdd);
+    shard.m_size.store(shard.m_data.size(), std::memory_order_relaxed);
+}
+
+template <class T>
+bool ShardedQueue<T>::popFrontInto(T& destination){
+    if(m_selection == Selection::POWER_OF_TWO_CHOICES && m_numberOfShards > 1){
+        int first = randomShard();
+        int second = randomShard();
+        if(m_shards[second].m_size.load(std::memory_order_relaxed) >
+           m_shards[first].m_size.load(std::memory_order_relaxed)){
+            first = second;
+        }
+        if(popFromShard(m_shards[first], destination)){
+            return true;
+        }
+    }
+
+    /* Round robin, which is also the fallback when both random choices were empty */
+    unsigned start = m_nextShard.fetch_add(1, std::memory_order_relaxed);
+    for(int i = 0 ; i < m_numberOfShards ; i++){
+        Shard& shard = m_shards[(start + i) % m_numberOfShards];
+        if(shard.m_size.load(std::memory_order_relaxed) > 0 && popFromShard(shard, destination)){
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+std::optional<T> ShardedQueue<T>::tryPopFront(){
+    T result;
+    if(!popFrontInto(result)){
+        return std::nullopt;
+    }
+    return std::optional<T>(std::move(result));
+}
+
+template <class T>
+int ShardedQueue<T>::size() const{
+    int result = 0;
+    for(int i = 0 ; i < m_numberOfShards ; i++){
+        result += m_shards[i].m_size.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+template <class T>
+int ShardedQueue<T>::exactSize() const{
+    /* Locks are taken in shard order, the only order any function holds more than one of them */
+    for(int i = 0 ; i < m_numberOfShards ; i++){
+        m_shards[i].m_mutex.lock();
+    }
+    int result = 0;
+    for(int i = 0 ; i < m_numberOfShards ; i++){
+        result += m_shards[i].m_data.size();
+    }
+    for(int i = m_numberOfShards - 1 ; i >= 0 ; i--){
+        m_shards[i].m_mutex.unlock();
+    }
+    return result;
+}
+
+template <class T>
+int ShardedQueue<T>::numberOfShards() const{
+    return m_numberOfShards;
+}
+
+template <class T>
+int ShardedQueue<T>::defaultNumberOfShards(){
+    int hardwareConcurrency = static_cast<int>(std::thread::hardware_concurrency());
+    return hardwareConcurrency > 0 ? hardwareConcurrency : 1;
+}
+
+/* --------------------------------- End of Public Functions of ShardedQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of ShardedQueue Class ------------------------------------*/
+
+template <class T>
+int ShardedQueue<T>::producerShard() const{
+#ifdef __linux__
+    if(m_ordering == Ordering::RELAXED_FIFO){
+        int cpu = sched_getcpu();
+        if(cpu >= 0){
+            return cpu % m_numberOfShards;
+        }
+    }
+#endif
+    /* Threads are numbered once, in the order they first push to any ShardedQueue */
+    static std::atomic<int> s_numberOfProducers(0);
+    static thread_local int t_producerIndex = s_numberOfProducers.fetch_add(1, std::memory_order_relaxed);
+    return t_producerIndex % m_numberOfShards;
+}
+
+template <class T>
+bool ShardedQueue<T>::popFromShard(Shard& shard, T& destination){
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    if(!shard.m_data.popFrontInto(destination)){
+        return false;
+    }
+    shard.m_size.store(shard.m_data.size(), std::memory_order_relaxed);
+    return true;
+}
+
+template <class T>
+int ShardedQueue<T>::randomShard() const{
+    static thread_local unsigned t_state = (0x9E3779B9u ^ static_cast<unsigned>(
+        std::hash<std::thread::id>()(std::this_thread::get_id()))) | 1u;
+    t_state ^= t_state << 13;
+    t_state ^= t_state >> 17;
+    t_state ^= t_state << 5;
+    return static_cast<int>(t_state % static_cast<unsigned>(m_numberOfShards));
+}
+
+/* -------------------------------- End of Private Functions of ShardedQueue Class --------------------------------*/
+
+#endif //SHARDED_QUEUE_H
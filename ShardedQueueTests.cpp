@@ -0,0 +1,70 @@
+#include <thread>
+
+#include "ShardedQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace ShardedQueueTests {
+
+bool testSingleThread()
+{
+	bool testResult = true;
+
+	ShardedQueue<int> queue(4, ShardedQueue<int>::Ordering::PER_PRODUCER_FIFO,
+		ShardedQueue<int>::Selection::POWER_OF_TWO_CHOICES);
+	int value = 0;
+	AGREGATE_TEST_RESULT(testResult, !queue.popFrontInto(value));
+
+	for (int i = 1; i <= 50; i++) {
+		queue.pushBack(i);
+	}
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 50 && queue.exactSize() == 50);
+
+	/* a single producer uses a single shard, so its elements come back in order */
+	for (int i = 1; i <= 50; i++) {
+		AGREGATE_TEST_RESULT(testResult, queue.tryPopFront().value() == i);
+	}
+	AGREGATE_TEST_RESULT(testResult, !queue.tryPopFront());
+	AGREGATE_TEST_RESULT(testResult, queue.exactSize() == 0);
+
+	return testResult;
+}
+
+bool testPerProducerOrder()
+{
+	bool testResult = true;
+
+	const int NUMBER_OF_PRODUCERS = 4;
+	const int ITEMS_PER_PRODUCER = 2000;
+	ShardedQueue<int> queue(3);
+	std::thread producers[NUMBER_OF_PRODUCERS];
+	for (int producer = 0; producer < NUMBER_OF_PRODUCERS; producer++) {
+		producers[producer] = std::thread([&queue, producer, ITEMS_PER_PRODUCER]() {
+			for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+				queue.pushBack(producer * ITEMS_PER_PRODUCER + i);
+			}
+		});
+	}
+
+	int lastSeen[NUMBER_OF_PRODUCERS] = { -1, -1, -1, -1 };
+	int received = 0;
+	while (received < NUMBER_OF_PRODUCERS * ITEMS_PER_PRODUCER) {
+		int value = 0;
+		if (!queue.popFrontInto(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		int producer = value / ITEMS_PER_PRODUCER;
+		AGREGATE_TEST_RESULT(testResult, value % ITEMS_PER_PRODUCER == lastSeen[producer] + 1);
+		lastSeen[producer] = value % ITEMS_PER_PRODUCER;
+		received++;
+	}
+	for (int producer = 0; producer < NUMBER_OF_PRODUCERS; producer++) {
+		producers[producer].join();
+	}
+	AGREGATE_TEST_RESULT(testResult, queue.exactSize() == 0);
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,395 @@
+#ifndef SHARED_MEMORY_QUEUE_H
+#define SHARED_MEMORY_QUEUE_H
+
+/* The waiting side sleeps on a futex, which is Linux only */
+#ifdef __linux__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+/*
+ * SharedMemoryQueue - Fixed capacity single producer, single consumer queue of trivially copyable elements,
+ * in a POSIX shared memory segment, so that two processes can pass elements without a pipe.
+ *
+ * One process creates the segment by name and the other opens it. The elements are a ring of capacity
+ * slots after a header that holds the two positions, each on a cache line of its own. Neither side takes
+ * a lock: a full or empty queue is waited on with a futex, and the other side only makes the wake-up system
+ * call when the header shows that someone is waiting.
+ *
+ * Exactly one process (or thread) may push, and exactly one may pop.
+*/
+template <class T>
+class SharedMemoryQueue {
+
+    static_assert(std::is_trivially_copyable<T>::value, "SharedMemoryQueue elements are copied as bytes");
+
+public:
+
+    /*
+     * C'tor that creates the shared memory segment. The segment is removed when this instance is destroyed.
+     *
+     * @param name - name of the segment, starting with '/'.
+     * @param capacity - the maximal number of elements, rounded up to a power of two.
+     * @return
+     * A new instance of SharedMemoryQueue.
+     * @exception
+     * InvalidArgument exception if capacity is not positive or larger than 2^30,
+     * SharedMemoryError exception if the segment cannot be created, for example if it already exists.
+    */
+    SharedMemoryQueue(const std::string& name, int capacity);
+
+    /*
+     * C'tor that opens a segment created by another process.
+     *
+     * @param name - name of the segment, starting with '/'.
+     * @return
+     * A new instance of SharedMemoryQueue.
+     * @exception
+     * SharedMemoryError exception if the segment does not exist or was created for a different T.
+    */
+    explicit SharedMemoryQueue(const std::string& name);
+
+    /*
+     * D'tor for SharedMemoryQueue class.
+     * Unmaps the segment, and removes its name if this instance created it.
+    */
+    ~SharedMemoryQueue();
+
+    /*
+     * The mapping and the ownership of the segment belong to one instance, so copying is not allowed.
+    */
+    SharedMemoryQueue(const SharedMemoryQueue& queue) = delete;
+    SharedMemoryQueue& operator=(const SharedMemoryQueue& otherQueue) = delete;
+
+    /*
+     * pushBack - Inserts a new member at the end of the queue, waiting while the queue is full.
+     * Producer only.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+    */
+    void pushBack(const T& argumentToAdd);
+
+    /*
+     * tryPushBack - Inserts a new member at the end of the queue if it is not full.
+     * Producer only.
+     *
+     * @param argumentToAdd - new member to add at the end of the queue.
+     * @return
+     * Returns true if the element was inserted, false if the queue is full.
+    */
+    bool tryPushBack(const T& argumentToAdd);
+
+    /*
+     * front - Returns the first element in the queue. Consumer only.
+     *
+     * @return
+     * Returns a const reference to the first element, valid until it is popped.
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    const T& front() const;
+
+    /*
+     * popFront - Removes the first element in the queue. Consumer only.
+     *
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    void popFront();
+
+    /*
+     * popFrontInto - Copies the first element in the queue into destination and removes it. Consumer only.
+     *
+     * @param destination - receives the first element.
+     * @return
+     * Returns true if an element was removed, false if the queue is empty.
+    */
+    bool popFrontInto(T& destination);
+
+    /*
+     * waitPopFrontInto - Like popFrontInto, but waits while the queue is empty. Consumer only.
+     *
+     * @param destination - receives the first element.
+    */
+    void waitPopFrontInto(T& destination);
+
+    /*
+     * size - the number of elements in the queue, as seen by the calling side.
+    */
+    int size() const;
+
+    /*
+     * capacity - the maximal number of elements in the queue.
+    */
+    int capacity() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    class EmptyQueue {};
+
+    /*
+     * InvalidArgument - Exception of invalid argument.
+    */
+    class InvalidArgument {};
+
+    /*
+     * SharedMemoryError - Exception for a segment that cannot be created, opened or mapped.
+    */
+    class SharedMemoryError {};
+
+private:
+
+    static const std::uint32_t MAGIC = 0x51554555;
+    static const std::uint32_t MAX_CAPACITY = 1u << 30;
+
+    /*
+     * Header - the start of the segment. Positions only grow, and wrap around at 2^32.
+     * A side that waits sets its waiting flag and sleeps on the position the other side moves.
+     * The other side clears the flag when it wakes the waiter, so it makes one system call per wait.
+    */
+    struct Header {
+        alignas(64) std::atomic<std::uint32_t> m_head;
+        std::atomic<std::uint32_t> m_consumerWaiting;
+        alignas(64) std::atomic<std::uint32_t> m_tail;
+        std::atomic<std::uint32_t> m_producerWaiting;
+        alignas(64) std::uint32_t m_capacity;
+        std::uint32_t m_elementSize;
+        std::atomic<std::uint32_t> m_magic;
+    };
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "positions must be address free atomics");
+
+    std::string m_name;
+    bool m_owner;
+    std::size_t m_mappedBytes;
+    Header* m_header;
+    T* m_data;
+    std::uint32_t m_mask;
+
+    /*
+     * dataOffset - offset of the ring from the start of the segment.
+    */
+    static std::size_t dataOffset();
+
+    /*
+     * map - maps the open segment of the given size and sets m_header and m_data.
+    */
+    void map(int fileDescriptor, std::size_t bytes);
+
+    /*
+     * futexWait - sleeps while the word holds the expected value.
+    */
+    static void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected);
+
+    /*
+     * futexWake - wakes the process sleeping on the word.
+    */
+    static void futexWake(std::atomic<std::uint32_t>& word);
+};
+
+
+/* ------------------------------------ Public Functions of SharedMemoryQueue Class ------------------------------------*/
+
+template <class T>
+SharedMemoryQueue<T>::SharedMemoryQueue(const std::string& name, int capacity) : m_name(name), m_owner(false),
+    m_mappedBytes(0), m_header(nullptr), m_data(nullptr), m_mask(0) {
+    if(capacity <= 0 || static_cast<std::uint32_t>(capacity) > MAX_CAPACITY){
+        throw InvalidArgument();
+    }
+    std::uint32_t roundedCapacity = 1;
+    while(roundedCapacity < static_cast<std::uint32_t>(capacity)){
+        roundedCapacity *= 2;
+    }
+
+    int fileDescriptor = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fileDescriptor < 0){
+        throw SharedMemoryError();
+    }
+    std::size_t bytes = dataOffset() + sizeof(T) * roundedCapacity;
+    if(ftruncate(fileDescriptor, static_cast<off_t>(bytes)) != 0){
+        close(fileDescriptor);
+        shm_unlink(m_name.c_str());
+        throw SharedMemoryError();
+    }
+    try{
+        map(fileDescriptor, bytes);
+    } catch(...){
+        shm_unlink(m_name.c_str());
+        throw;
+    }
+    m_owner = true;
+
+    /* ftruncate filled the segment with zeros, so the positions and flags already start at 0 */
+    m_header->m_capacity = roundedCapacity;
+    m_header->m_elementSize = sizeof(T);
+    m_mask = roundedCapacity - 1;
+    m_header->m_magic.store(MAGIC, std::memory_order_release);
+}
+
+template <class T>
+SharedMemoryQueue<T>::SharedMemoryQueue(const std::string& name) : m_name(name), m_owner(false), m_mappedBytes(0),
+    m_header(nullptr), m_data(nullptr), m_mask(0) {
+    int fileDescriptor = shm_open(m_name.c_str(), O_RDWR, 0600);
+    if(fileDescriptor < 0){
+        throw SharedMemoryError();
+    }
+    struct stat status;
+    if(fstat(fileDescriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < dataOffset()){
+        close(fileDescriptor);
+        throw SharedMemoryError();
+    }
+    map(fileDescriptor, static_cast<std::size_t>(status.st_size));
+    if(m_header->m_magic.load(std::memory_order_acquire) != MAGIC || m_header->m_elementSize != sizeof(T) ||
+       dataOffset() + sizeof(T) * m_header->m_capacity > m_mappedBytes){
+        munmap(m_header, m_mappedBytes);
+        throw SharedMemoryError();
+    }
+    m_mask = m_header->m_capacity - 1;
+}
+
+template <class T>
+SharedMemoryQueue<T>::~SharedMemoryQueue(){
+    munmap(m_header, m_mappedBytes);
+    if(m_owner){
+        shm_unlink(m_name.c_str());
+    }
+}
+
+template <class T>
+void SharedMemoryQueue<T>::pushBack(const T& argumentToAdd){
+    while(!tryPushBack(argumentToAdd)){
+        std::uint32_t head = m_header->m_head.load(std::memory_order_seq_cst);
+        m_header->m_producerWaiting.store(1, std::memory_order_seq_cst);
+        /* Checked again after raising the flag, so a pop between the two is not missed */
+        if(m_header->m_tail.load(std::memory_order_relaxed) - m_header->m_head.load(std::memory_order_seq_cst) >
+           m_mask){
+            futexWait(m_header->m_head, head);
+        }
+    }
+}
+
+template <class T>
+bool SharedMemoryQueue<T>::tryPushBack(const T& argumentToAdd){
+    std::uint32_t tail = m_header->m_tail.load(std::memory_order_relaxed);
+    if(tail - m_header->m_head.load(std::memory_order_acquire) > m_mask){
+        return false;
+    }
+    std::memcpy(static_cast<void*>(m_data + (tail & m_mask)), &argumentToAdd, sizeof(T));
+    m_header->m_tail.store(tail + 1, std::memory_order_seq_cst);
+    if(m_header->m_consumerWaiting.exchange(0, std::memory_order_seq_cst) != 0){
+        futexWake(m_header->m_tail);
+    }
+    return true;
+}
+
+template <class T>
+const T& SharedMemoryQueue<T>::front() const{
+    std::uint32_t head = m_header->m_head.load(std::memory_order_relaxed);
+    if(m_header->m_tail.load(std::memory_order_acquire) == head){
+        throw EmptyQueue();
+    }
+    return m_data[head & m_mask];
+}
+
+template <class T>
+void SharedMemoryQueue<T>::popFront(){
+    std::uint32_t head = m_header->m_head.load(std::memory_order_relaxed);
+    if(m_header->m_tail.load(std::memory_order_acquire) == head){
+        throw EmptyQueue();
+    }
+    m_header->m_head.store(head + 1, std::memory_order_seq_cst);
+    if(m_header->m_producerWaiting.exchange(0, std::memory_order_seq_cst) != 0){
+        futexWake(m_header->m_head);
+    }
+}
+
+template <class T>
+bool SharedMemoryQueue<T>::popFrontInto(T& destination){
+    std::uint32_t head = m_header->m_head.load(std::memory_order_relaxed);
+    if(m_header->m_tail.load(std::memory_order_acquire) == head){
+        return false;
+    }
+    std::memcpy(static_cast<void*>(&destination), m_data + (head & m_mask), sizeof(T));
+    m_header->m_head.store(head + 1, std::memory_order_seq_cst);
+    if(m_header->m_producerWaiting.exchange(0, std::memory_order_seq_cst) != 0){
+        futexWake(m_header->m_head);
+    }
+    return true;
+}
+
+template <class T>
+void SharedMemoryQueue<T>::waitPopFrontInto(T& destination){
+    while(!popFrontInto(destination)){
+        std::uint32_t tail = m_header->m_tail.load(std::memory_order_seq_cst);
+        m_header->m_consumerWaiting.store(1, std::memory_order_seq_cst);
+        /* Checked again after raising the flag, so a push between the two is not missed */
+        if(m_header->m_tail.load(std::memory_order_seq_cst) == m_header->m_head.load(std::memory_order_relaxed)){
+            futexWait(m_header->m_tail, tail);
+        }
+    }
+}
+
+template <class T>
+int SharedMemoryQueue<T>::size() const{
+    return static_cast<int>(m_header->m_tail.load(std::memory_order_acquire) -
+                            m_header->m_head.load(std::memory_order_acquire));
+}
+
+template <class T>
+int SharedMemoryQueue<T>::capacity() const{
+    return static_cast<int>(m_mask + 1);
+}
+
+/* --------------------------------- End of Public Functions of SharedMemoryQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of SharedMemoryQueue Class ------------------------------------*/
+
+template <class T>
+std::size_t SharedMemoryQueue<T>::dataOffset(){
+    std::size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+    return (sizeof(Header) + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+void SharedMemoryQueue<T>::map(int fileDescriptor, std::size_t bytes){
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if(memory == MAP_FAILED){
+        throw SharedMemoryError();
+    }
+    m_mappedBytes = bytes;
+    m_header = static_cast<Header*>(memory);
+    m_data = reinterpret_cast<T*>(static_cast<char*>(memory) + dataOffset());
+}
+
+template <class T>
+void SharedMemoryQueue<T>::futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected){
+    /* Not FUTEX_PRIVATE_FLAG, the other side is another process. Spurious wake-ups are handled by the callers */
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+template <class T>
+void SharedMemoryQueue<T>::futexWake(std::atomic<std::uint32_t>& word){
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+/* -------------------------------- End of Private Functions of SharedMemoryQueue Class --------------------------------*/
+
+#endif //__linux__
+
+#endif //SHARED_MEMORY_QUEUE_H
@@ -0,0 +1,108 @@
+#include <string>
+
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "SharedMemoryQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace SharedMemoryQueueTests {
+
+#ifdef __linux__
+static std::string segmentName(const char* test)
+{
+	return std::string("/queue-") + test + "-" + std::to_string(getpid());
+}
+#endif
+
+bool testSingleProcess()
+{
+	bool testResult = true;
+#ifdef __linux__
+	std::string name = segmentName("single");
+	SharedMemoryQueue<int> producer(name, 3);
+	SharedMemoryQueue<int> consumer(name);
+	AGREGATE_TEST_RESULT(testResult, producer.capacity() == 4 && consumer.capacity() == 4);
+	for (int i = 1; i <= 4; i++) {
+		AGREGATE_TEST_RESULT(testResult, producer.tryPushBack(i));
+	}
+	AGREGATE_TEST_RESULT(testResult, !producer.tryPushBack(5) && consumer.size() == 4);
+	AGREGATE_TEST_RESULT(testResult, consumer.front() == 1);
+	consumer.popFront();
+	int value = 0;
+	AGREGATE_TEST_RESULT(testResult, consumer.popFrontInto(value) && value == 2);
+	producer.pushBack(5);
+	consumer.waitPopFrontInto(value);
+	AGREGATE_TEST_RESULT(testResult, value == 3 && consumer.size() == 2);
+	consumer.popFront();
+	consumer.popFront();
+
+	bool exceptionThrown = false;
+	try {
+		consumer.front();
+	}
+	catch (SharedMemoryQueue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown && !consumer.popFrontInto(value));
+
+	exceptionThrown = false;
+	try {
+		SharedMemoryQueue<long long> wrongType(name);
+	}
+	catch (SharedMemoryQueue<long long>::SharedMemoryError& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	exceptionThrown = false;
+	try {
+		SharedMemoryQueue<int> duplicate(name, 4);
+	}
+	catch (SharedMemoryQueue<int>::SharedMemoryError& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+#endif
+	return testResult;
+}
+
+bool testTwoProcesses()
+{
+	bool testResult = true;
+#ifdef __linux__
+	const int NUMBER_OF_ELEMENTS = 20000;
+	std::string name = segmentName("fork");
+	/* A small ring, so both the producer and the consumer have to wait for each other */
+	SharedMemoryQueue<long long> consumer(name, 16);
+	pid_t child = fork();
+	if (child == 0) {
+		try {
+			SharedMemoryQueue<long long> producer(name);
+			for (long long i = 0; i < NUMBER_OF_ELEMENTS; i++) {
+				producer.pushBack(i * i);
+			}
+		}
+		catch (...) {
+			_exit(1);
+		}
+		_exit(0);
+	}
+	AGREGATE_TEST_RESULT(testResult, child > 0);
+
+	long long value = 0;
+	for (long long i = 0; child > 0 && i < NUMBER_OF_ELEMENTS; i++) {
+		consumer.waitPopFrontInto(value);
+		AGREGATE_TEST_RESULT(testResult, value == i * i);
+	}
+	int status = 0;
+	AGREGATE_TEST_RESULT(testResult, child > 0 && waitpid(child, &status, 0) == child);
+	AGREGATE_TEST_RESULT(testResult, WIFEXITED(status) && WEXITSTATUS(status) == 0 && consumer.size() == 0);
+#endif
+	return testResult;
+}
+
+}
@@ -0,0 +1,109 @@
+#include "SingleThreadedExecutor.h"
+
+#include <utility>
+
+
+/* ------------------------------------------- AsyncTask Class ------------------------------------------- */
+
+AsyncTask AsyncTask::promise_type::get_return_object(){
+    return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+void AsyncTask::promise_type::unhandled_exception(){
+    if(m_executor != nullptr && !m_executor->m_error){
+        m_executor->m_error = std::current_exception();
+    }
+}
+
+AsyncTask::AsyncTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+AsyncTask::AsyncTask(AsyncTask&& task) noexcept : m_handle(std::exchange(task.m_handle, nullptr)) {}
+
+AsyncTask::~AsyncTask(){
+    if(m_handle){
+        m_handle.destroy();
+    }
+}
+
+/* --------------------------------------- SingleThreadedExecutor Class --------------------------------------- */
+
+SingleThreadedExecutor::SingleThreadedExecutor() : m_ownerThread(std::this_thread::get_id()),
+    m_hasRemoteReady(false), m_stop(false) {}
+
+void SingleThreadedExecutor::spawn(AsyncTask task){
+    task.m_handle.promise().m_executor = this;
+    schedule(task.m_handle);
+    task.m_handle = nullptr;
+}
+
+void SingleThreadedExecutor::schedule(std::coroutine_handle<> handle){
+    if(isOwnerThread()){
+        m_localReady.pushBack(handle);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_remoteMutex);
+        m_remoteReady.pushBack(handle);
+        m_hasRemoteReady = true;
+    }
+    m_remoteAvailable.notify_one();
+}
+
+int SingleThreadedExecutor::runUntilIdle(){
+    int resumed = 0;
+    while(true){
+        if(m_localReady.size() == 0){
+            takeRemoteReady();
+            if(m_localReady.size() == 0){
+                return resumed;
+            }
+        }
+        m_localReady.popAndGet().resume();
+        resumed++;
+        rethrowError();
+    }
+}
+
+void SingleThreadedExecutor::run(){
+    while(true){
+        runUntilIdle();
+        std::unique_lock<std::mutex> lock(m_remoteMutex);
+        m_remoteAvailable.wait(lock, [this]() { return m_stop.load() || m_hasRemoteReady.load(); });
+        if(!m_hasRemoteReady.load() && m_localReady.size() == 0){
+            m_stop = false;
+            return;
+        }
+    }
+}
+
+void SingleThreadedExecutor::stop(){
+    {
+        std::lock_guard<std::mutex> lock(m_remoteMutex);
+        m_stop = true;
+    }
+    m_remoteAvailable.notify_one();
+}
+
+bool SingleThreadedExecutor::isOwnerThread() const{
+    return std::this_thread::get_id() == m_ownerThread;
+}
+
+void SingleThreadedExecutor::takeRemoteReady(){
+    if(!m_hasRemoteReady.load()){
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_remoteMutex);
+    std::coroutine_handle<> handle;
+    while(m_remoteReady.popFrontInto(handle)){
+        m_localReady.pushBack(handle);
+    }
+    m_hasRemoteReady = false;
+}
+
+void SingleThreadedExecutor::rethrowError(){
+    if(m_error){
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
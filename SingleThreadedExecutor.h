@@ -0,0 +1,157 @@
+#ifndef SINGLE_THREADED_EXECUTOR_H
+#define SINGLE_THREADED_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "Queue.h"
+
+
+class SingleThreadedExecutor;
+
+/*
+ * AsyncTask - Fire and forget coroutine that runs on a SingleThreadedExecutor.
+ * A coroutine returning AsyncTask starts suspended, and runs once it is given to SingleThreadedExecutor::spawn.
+ * An exception escaping the coroutine is rethrown from the executor's run function.
+*/
+class AsyncTask {
+
+public:
+
+    struct promise_type {
+        SingleThreadedExecutor* m_executor = nullptr;
+
+        AsyncTask get_return_object();
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    /*
+     * The coroutine frame has a single owner, so copying is not allowed.
+    */
+    AsyncTask(AsyncTask&& task) noexcept;
+    AsyncTask(const AsyncTask& task) = delete;
+    AsyncTask& operator=(const AsyncTask& otherTask) = delete;
+
+    /*
+     * D'tor for AsyncTask class.
+     * Destroys the coroutine if it was never spawned.
+    */
+    ~AsyncTask();
+
+private:
+
+    std::coroutine_handle<promise_type> m_handle;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle);
+    friend class SingleThreadedExecutor;
+};
+
+
+/*
+ * SingleThreadedExecutor - Runs coroutines on the thread that created it.
+ * Scheduling from the owner thread is a plain queue push, scheduling from any other thread
+ * takes a lock and wakes the owner up.
+*/
+class SingleThreadedExecutor {
+
+public:
+
+    /*
+     * C'tor for SingleThreadedExecutor class. The calling thread becomes the owner thread.
+     *
+     * @return
+     * A new instance of SingleThreadedExecutor.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    SingleThreadedExecutor();
+
+    /*
+     * Coroutines hold the address of the executor, so copying is not allowed.
+    */
+    SingleThreadedExecutor(const SingleThreadedExecutor& executor) = delete;
+    SingleThreadedExecutor& operator=(const SingleThreadedExecutor& otherExecutor) = delete;
+    ~SingleThreadedExecutor() = default;
+
+    /*
+     * spawn - Takes ownership of a task and schedules its first run.
+     *
+     * @param task - the task to run.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    void spawn(AsyncTask task);
+
+    /*
+     * schedule - Schedules a suspended coroutine to be resumed by the owner thread. May be called from any thread.
+     *
+     * @param handle - the coroutine to resume.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    void schedule(std::coroutine_handle<> handle);
+
+    /*
+     * runUntilIdle - Resumes coroutines until none is ready. Owner thread only.
+     *
+     * @return
+     * Returns the number of coroutines that were resumed.
+     * @exception
+     * Rethrows an exception that escaped one of the coroutines.
+    */
+    int runUntilIdle();
+
+    /*
+     * run - Resumes coroutines, sleeping while none is ready, until stop is called. Owner thread only.
+     *
+     * @exception
+     * Rethrows an exception that escaped one of the coroutines.
+    */
+    void run();
+
+    /*
+     * stop - Makes run return once no coroutine is ready. May be called from any thread.
+    */
+    void stop();
+
+    /*
+     * isOwnerThread - checks if the calling thread is the owner thread.
+    */
+    bool isOwnerThread() const;
+
+private:
+
+    std::thread::id m_ownerThread;
+
+    /* Coroutines scheduled by the owner thread, never touched by other threads */
+    Queue<std::coroutine_handle<>> m_localReady;
+
+    std::mutex m_remoteMutex;
+    std::condition_variable m_remoteAvailable;
+    Queue<std::coroutine_handle<>> m_remoteReady;
+    std::atomic<bool> m_hasRemoteReady;
+    std::atomic<bool> m_stop;
+
+    std::exception_ptr m_error;
+
+    /*
+     * takeRemoteReady - moves the coroutines scheduled by other threads to the local queue.
+    */
+    void takeRemoteReady();
+
+    /*
+     * rethrowError - rethrows and clears the exception of a coroutine, if there is one.
+    */
+    void rethrowError();
+
+    friend struct AsyncTask::promise_type;
+};
+
+#endif //SINGLE_THREADED_EXECUTOR_H
@@ -0,0 +1,494 @@
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "QueueBufferCache.h"
+
+
+/*
+ * TaskQueue - FIFO queue of callables of any type taking no arguments, stored inline in one byte ring.
+ * Every task is a record of a TaskHeader followed by the callable itself, so pushing a task only constructs
+ * it in the ring - there is no per task allocation, and growing the ring moves each callable once.
+ * Move only callables are supported. runFront calls the task in place in the ring and then destroys it.
+ *
+ * Callables larger than MAX_INLINE_BYTES, over-aligned, or whose move may throw are boxed: they are
+ * constructed in an array from the thread's QueueBufferCache, which recycles freed arrays, and the record
+ * holds a pointer to it. Once the ring and the cache have grown to the working set, pushing and running
+ * tasks does not allocate.
+ *
+ * A task may push new tasks to the queue it runs from, but must not run, pop or destroy tasks of it.
+ * A TaskQueue is not thread safe.
+*/
+class TaskQueue {
+
+public:
+
+    /* The alignment of the records, and of the callables stored inline */
+    static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    /* The largest callable stored inline */
+    static const std::size_t MAX_INLINE_BYTES = 128;
+
+    /* The size of the ring of a new TaskQueue */
+    static const std::size_t INITIAL_BYTES = 1024;
+
+    /*
+     * C'tor for TaskQueue class.
+     *
+     * @param initialBytes - the initial size of the ring, rounded up to a multiple of QueueBufferCache::ALIGNMENT.
+     * @return
+     * A new, empty instance of TaskQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit TaskQueue(std::size_t initialBytes = INITIAL_BYTES);
+
+    /*
+     * D'tor for TaskQueue class. Destroys the remaining tasks without running them.
+    */
+    ~TaskQueue();
+
+    /*
+     * The ring holds callables of unknown type that may be move only, so copying is not allowed.
+    */
+    TaskQueue(const TaskQueue& queue) = delete;
+    TaskQueue& operator=(const TaskQueue& otherQueue) = delete;
+
+    /*
+     * pushBack - Inserts a new task at the end of the queue, moving or copying the callable into the ring.
+     *
+     * @param task - the callable, called with no arguments. Its result is ignored.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the construction of the callable,
+     * in both cases the queue is unchanged.
+    */
+    template <class Function>
+    void pushBack(Function&& task);
+
+    /*
+     * runFront - Calls the first task in the queue, then destroys and removes it.
+     * The task is removed even if it throws.
+     *
+     * @return
+     * Returns true if a task was run, false if the queue is empty.
+     * @exception
+     * A random exception might be thrown by the task.
+    */
+    bool runFront();
+
+    /*
+     * runAll - Runs tasks until the queue is empty, including the tasks pushed by the tasks that run.
+     *
+     * @return
+     * Returns the number of tasks that were run.
+     * @exception
+     * A random exception might be thrown by a task, which stops the run after removing that task.
+    */
+    int runAll();
+
+    /*
+     * popFront - Destroys and removes the first task in the queue without running it.
+     *
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    void popFront();
+
+    /*
+     * size - the number of tasks in the queue.
+    */
+    int size() const;
+
+    /*
+     * capacityBytes - the size of the ring.
+    */
+    std::size_t capacityBytes() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    class EmptyQueue {};
+
+private:
+
+    /*
+     * TaskOperations - how to call, move and destroy the callable of a record, one table per stored type.
+     * relocate move constructs the callable at a new address and destroys the old one, and never throws.
+    */
+    struct TaskOperations {
+        void (*m_invokeAndDestroy)(void* storage);
+        void (*m_relocate)(void* from, void* to) noexcept;
+        void (*m_destroy)(void* storage) noexcept;
+    };
+
+    /*
+     * TaskHeader - the start of a record, the callable follows it. A record with no operations is padding
+     * that fills the end of the ring when the next record did not fit there.
+    */
+    struct alignas(ALIGNMENT) TaskHeader {
+        const TaskOperations* m_operations;
+        std::size_t m_bytes;
+    };
+
+    unsigned char* m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_head;
+    std::size_t m_tail;
+    std::size_t m_usedBytes;
+    int m_size;
+
+    /* The task being run - it stays in its record until it returns, and is not moved if the ring grows */
+    bool m_running;
+    unsigned char* m_retiredBuffer;
+    std::size_t m_retiredCapacity;
+
+    template <class Function>
+    static constexpr bool IS_INLINE = sizeof(Function) <= MAX_INLINE_BYTES && alignof(Function) <= ALIGNMENT &&
+                                      std::is_nothrow_move_constructible<Function>::value;
+
+    template <class Function>
+    static const TaskOperations INLINE_OPERATIONS;
+
+    template <class Function>
+    static const TaskOperations BOXED_OPERATIONS;
+
+    template <class Function>
+    static void invokeInline(void* storage);
+
+    template <class Function>
+    static void relocateInline(void* from, void* to) noexcept;
+
+    template <class Function>
+    static void destroyInline(void* storage) noexcept;
+
+    template <class Function>
+    static void invokeBoxed(void* storage);
+
+    static void relocateBoxed(void* from, void* to) noexcept;
+
+    template <class Function>
+    static void destroyBoxed(void* storage) noexcept;
+
+    /*
+     * recordBytes - the size of the record of a callable of the given size, header included.
+    */
+    static std::size_t recordBytes(std::size_t storageBytes) noexcept;
+
+    /*
+     * blockBytes - the given size rounded up to a multiple of QueueBufferCache::ALIGNMENT.
+    */
+    static std::size_t blockBytes(std::size_t bytes) noexcept;
+
+    /*
+     * reserveRecord - finds room for a record at the end of the ring, growing the ring if needed.
+     *
+     * @return
+     * Returns the offset of the record, which is m_tail, or 0 if the record does not fit at the end of the ring.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is unchanged.
+    */
+    std::size_t reserveRecord(std::size_t bytes);
+
+    /*
+     * commitRecord - adds the record constructed at the offset from reserveRecord to the queue.
+    */
+    void commitRecord(std::size_t offset, const TaskOperations* operations, std::size_t bytes) noexcept;
+
+    /*
+     * grow - moves the records to the beginning of a larger ring. The record of the running task stays in
+     * the old ring, which is freed once the task returns.
+    */
+    void grow(std::size_t bytes);
+
+    /*
+     * frontHeader - the header of the first task, skipping the padding at the end of the ring.
+    */
+    TaskHeader* frontHeader() noexcept;
+
+    /*
+     * removeFront - gives back the bytes of the first record.
+    */
+    void removeFront(std::size_t bytes) noexcept;
+
+    static void* storageOf(TaskHeader* header) noexcept;
+};
+
+
+/* ------------------------------------ Public Functions of TaskQueue Class ------------------------------------*/
+
+inline TaskQueue::TaskQueue(std::size_t initialBytes) : m_buffer(nullptr), m_capacity(blockBytes(initialBytes)),
+    m_head(0), m_tail(0), m_usedBytes(0), m_size(0), m_running(false), m_retiredBuffer(nullptr), m_retiredCapacity(0) {
+    m_buffer = static_cast<unsigned char*>(QueueBufferCache::allocate(m_capacity));
+}
+
+inline TaskQueue::~TaskQueue(){
+    while(m_size > 0){
+        popFront();
+    }
+    QueueBufferCache::deallocate(m_buffer, m_capacity);
+}
+
+template <class Function>
+void TaskQueue::pushBack(Function&& task){
+    typedef typename std::decay<Function>::type Stored;
+    static_assert(alignof(Stored) <= QueueBufferCache::ALIGNMENT, "TaskQueue does not support this alignment");
+    if constexpr(IS_INLINE<Stored>){
+        std::size_t bytes = recordBytes(sizeof(Stored));
+        std::size_t offset = reserveRecord(bytes);
+        new (storageOf(reinterpret_cast<TaskHeader*>(m_buffer + offset))) Stored(std::forward<Function>(task));
+        commitRecord(offset, &INLINE_OPERATIONS<Stored>, bytes);
+    }
+    else{
+        std::size_t bytes = recordBytes(sizeof(Stored*));
+        std::size_t offset = reserveRecord(bytes);
+        void* box = QueueBufferCache::allocate(blockBytes(sizeof(Stored)));
+        try{
+            new (box) Stored(std::forward<Function>(task));
+        } catch(...){
+            QueueBufferCache::deallocate(box, blockBytes(sizeof(Stored)));
+            throw;
+        }
+        *static_cast<Stored**>(storageOf(reinterpret_cast<TaskHeader*>(m_buffer + offset))) = static_cast<Stored*>(box);
+        commitRecord(offset, &BOXED_OPERATIONS<Stored>, bytes);
+    }
+}
+
+inline bool TaskQueue::runFront(){
+    if(m_size == 0){
+        return false;
+    }
+    TaskHeader* header = frontHeader();
+    std::size_t bytes = header->m_bytes;
+
+    /* Gives back the record when the task returns or throws, it is destroyed by then */
+    struct Finish {
+        TaskQueue& m_queue;
+        std::size_t m_bytes;
+        ~Finish(){
+            m_queue.m_running = false;
+            if(m_queue.m_retiredBuffer != nullptr){
+                QueueBufferCache::deallocate(m_queue.m_retiredBuffer, m_queue.m_retiredCapacity);
+                m_queue.m_retiredBuffer = nullptr;
+                m_queue.m_size--;
+                return;
+            }
+            m_queue.removeFront(m_bytes);
+        }
+    } finish{ *this, bytes };
+
+    m_running = true;
+    header->m_operations->m_invokeAndDestroy(storageOf(header));
+    return true;
+}
+
+inline int TaskQueue::runAll(){
+    int numberOfTasks = 0;
+    while(runFront()){
+        numberOfTasks++;
+    }
+    return numberOfTasks;
+}
+
+inline void TaskQueue::popFront(){
+    if(m_size == 0){
+        throw EmptyQueue();
+    }
+    TaskHeader* header = frontHeader();
+    header->m_operations->m_destroy(storageOf(header));
+    removeFront(header->m_bytes);
+}
+
+inline int TaskQueue::size() const{
+    return m_size;
+}
+
+inline std::size_t TaskQueue::capacityBytes() const{
+    return m_capacity;
+}
+
+/* --------------------------------- End of Public Functions of TaskQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of TaskQueue Class ------------------------------------*/
+
+template <class Function>
+const TaskQueue::TaskOperations TaskQueue::INLINE_OPERATIONS = {
+    &TaskQueue::invokeInline<Function>, &TaskQueue::relocateInline<Function>, &TaskQueue::destroyInline<Function>
+};
+
+template <class Function>
+const TaskQueue::TaskOperations TaskQueue::BOXED_OPERATIONS = {
+    &TaskQueue::invokeBoxed<Function>, &TaskQueue::relocateBoxed, &TaskQueue::destroyBoxed<Function>
+};
+
+template <class Function>
+void TaskQueue::invokeInline(void* storage){
+    Function* task = static_cast<Function*>(storage);
+    struct Destroy {
+        Function* m_task;
+        ~Destroy(){
+            m_task->~Function();
+        }
+    } destroy{ task };
+    (*task)();
+}
+
+template <class Function>
+void TaskQueue::relocateInline(void* from, void* to) noexcept{
+    Function* task = static_cast<Function*>(from);
+    new (to) Function(std::move(*task));
+    task->~Function();
+}
+
+template <class Function>
+void TaskQueue::destroyInline(void* storage) noexcept{
+    static_cast<Function*>(storage)->~Function();
+}
+
+template <class Function>
+void TaskQueue::invokeBoxed(void* storage){
+    Function* task = *static_cast<Function**>(storage);
+    struct Destroy {
+        Function* m_task;
+        ~Destroy(){
+            destroyBoxed<Function>(&m_task);
+        }
+    } destroy{ task };
+    (*task)();
+}
+
+inline void TaskQueue::relocateBoxed(void* from, void* to) noexcept{
+    *static_cast<void**>(to) = *static_cast<void**>(from);
+}
+
+template <class Function>
+void TaskQueue::destroyBoxed(void* storage) noexcept{
+    Function* task = *static_cast<Function**>(storage);
+    task->~Function();
+    QueueBufferCache::deallocate(task, blockBytes(sizeof(Function)));
+}
+
+inline std::size_t TaskQueue::recordBytes(std::size_t storageBytes) noexcept{
+    return sizeof(TaskHeader) + (storageBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+inline std::size_t TaskQueue::blockBytes(std::size_t bytes) noexcept{
+    std::size_t alignment = QueueBufferCache::ALIGNMENT;
+    return bytes == 0 ? alignment : (bytes + alignment - 1) / alignment * alignment;
+}
+
+inline std::size_t TaskQueue::reserveRecord(std::size_t bytes){
+    if(m_usedBytes == 0){
+        m_head = 0;
+        m_tail = 0;
+    }
+    bool wrapped = m_tail < m_head || (m_tail == m_head && m_usedBytes > 0);
+    if(!wrapped){
+        if(bytes <= m_capacity - m_tail){
+            return m_tail;
+        }
+        if(bytes <= m_head){
+            return 0;
+        }
+    }
+    else if(bytes <= m_head - m_tail){
+        return m_tail;
+    }
+    grow(bytes);
+    return m_tail;
+}
+
+inline void TaskQueue::commitRecord(std::size_t offset, const TaskOperations* operations, std::size_t bytes) noexcept{
+    if(offset != m_tail && m_tail < m_capacity){
+        /* The record did not fit at the end of the ring, so the end is padded and the record is at the beginning */
+        TaskHeader* padding = reinterpret_cast<TaskHeader*>(m_buffer + m_tail);
+        padding->m_operations = nullptr;
+        padding->m_bytes = m_capacity - m_tail;
+        m_usedBytes += padding->m_bytes;
+    }
+    TaskHeader* header = reinterpret_cast<TaskHeader*>(m_buffer + offset);
+    header->m_operations = operations;
+    header->m_bytes = bytes;
+    m_tail = offset + bytes;
+    m_usedBytes += bytes;
+    m_size++;
+}
+
+inline void TaskQueue::grow(std::size_t bytes){
+    std::size_t newCapacity = m_capacity * 2;
+    while(newCapacity < m_usedBytes + bytes){
+        newCapacity *= 2;
+    }
+    unsigned char* newBuffer = static_cast<unsigned char*>(QueueBufferCache::allocate(newCapacity));
+
+    /* The running task stays in the old ring, unless the ring already grew while it runs */
+    bool skipRunning = m_running && m_retiredBuffer == nullptr;
+    std::size_t position = m_head;
+    std::size_t newTail = 0;
+    std::size_t remaining = m_usedBytes;
+    bool first = true;
+    while(remaining > 0){
+        if(position == m_capacity){
+            position = 0;
+        }
+        TaskHeader* header = reinterpret_cast<TaskHeader*>(m_buffer + position);
+        std::size_t recordSize = header->m_bytes;
+        /* Padding is dropped */
+        if(header->m_operations != nullptr && !(first && skipRunning)){
+            TaskHeader* newHeader = reinterpret_cast<TaskHeader*>(newBuffer + newTail);
+            newHeader->m_operations = header->m_operations;
+            newHeader->m_bytes = recordSize;
+            header->m_operations->m_relocate(storageOf(header), storageOf(newHeader));
+            newTail += recordSize;
+        }
+        first = first && header->m_operations == nullptr;
+        position += recordSize;
+        remaining -= recordSize;
+    }
+
+    if(skipRunning){
+        m_retiredBuffer = m_buffer;
+        m_retiredCapacity = m_capacity;
+    }
+    else{
+        QueueBufferCache::deallocate(m_buffer, m_capacity);
+    }
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    m_head = 0;
+    m_tail = newTail;
+    m_usedBytes = newTail;
+}
+
+inline TaskQueue::TaskHeader* TaskQueue::frontHeader() noexcept{
+    TaskHeader* header = reinterpret_cast<TaskHeader*>(m_buffer + m_head);
+    if(header->m_operations == nullptr){
+        m_usedBytes -= header->m_bytes;
+        m_head = 0;
+        header = reinterpret_cast<TaskHeader*>(m_buffer);
+    }
+    return header;
+}
+
+inline void TaskQueue::removeFront(std::size_t bytes) noexcept{
+    m_head += bytes;
+    if(m_head == m_capacity){
+        m_head = 0;
+    }
+    m_usedBytes -= bytes;
+    m_size--;
+}
+
+inline void* TaskQueue::storageOf(TaskHeader* header) noexcept{
+    return header + 1;
+}
+
+/* -------------------------------- End of Private Functions of TaskQueue Class --------------------------------*/
+
+#endif //TASK_QUEUE_H
@@ -0,0 +1,114 @@
+#include <memory>
+#include <string>
+
+#include "Queue.h"
+#include "TaskQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace TaskQueueTests {
+
+/* Counts its live copies, to check that every task is destroyed exactly once */
+struct Counted {
+	static int s_alive;
+	Counted() { s_alive++; }
+	Counted(const Counted&) { s_alive++; }
+	~Counted() { s_alive--; }
+};
+
+int Counted::s_alive = 0;
+
+bool testRunInOrder()
+{
+	bool testResult = true;
+
+	TaskQueue queue(64);
+	Queue<int> order;
+	std::unique_ptr<int> moveOnly(new int(7));
+	char large[300] = { 'x' };
+	for (int i = 0; i < 40; i++) {
+		if (i % 10 == 3) {
+			queue.pushBack([&order, large, i]() { order.pushBack(large[0] == 'x' ? i : -1); });
+		}
+		else {
+			queue.pushBack([&order, i]() { order.pushBack(i); });
+		}
+	}
+	queue.pushBack([&order, value = std::move(moveOnly)]() { order.pushBack(*value); });
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 41 && queue.capacityBytes() > 64);
+
+	/* half of the tasks run, then the ring wraps around while the rest are still queued */
+	for (int i = 0; i < 20; i++) {
+		AGREGATE_TEST_RESULT(testResult, queue.runFront());
+	}
+	std::string label = "label";
+	for (int i = 40; i < 50; i++) {
+		queue.pushBack([&order, label, i]() { order.pushBack(label.size() == 5 ? i : -1); });
+	}
+
+	/* a running task pushes enough tasks to make the ring grow under it */
+	queue.pushBack([&queue, &order]() {
+		for (int i = 100; i < 200; i++) {
+			queue.pushBack([&order, i]() { order.pushBack(i); });
+		}
+		order.pushBack(99);
+	});
+	AGREGATE_TEST_RESULT(testResult, queue.runAll() == 132 && queue.size() == 0 && !queue.runFront());
+
+	/* 0..39, the move only task, 40..49, the task that pushed, and 100..199 */
+	AGREGATE_TEST_RESULT(testResult, order.size() == 152 && order[40] == 7 && order[51] == 99);
+	for (int i = 0; i < 152; i++) {
+		if (i != 40 && i != 51) {
+			AGREGATE_TEST_RESULT(testResult, order[i] == (i < 40 ? i : i < 51 ? i - 1 : i + 48));
+		}
+	}
+
+	return testResult;
+}
+
+bool testDestroyAndThrow()
+{
+	bool testResult = true;
+
+	Counted counted;
+	{
+		TaskQueue queue;
+		for (int i = 0; i < 100; i++) {
+			queue.pushBack([counted]() {});
+		}
+		char large[500] = {};
+		queue.pushBack([counted, large]() { (void)large; });
+		AGREGATE_TEST_RESULT(testResult, Counted::s_alive == 102);
+		queue.runFront();
+		queue.popFront();
+		AGREGATE_TEST_RESULT(testResult, Counted::s_alive == 100 && queue.size() == 99);
+	}
+	AGREGATE_TEST_RESULT(testResult, Counted::s_alive == 1);
+
+	TaskQueue queue;
+	int runs = 0;
+	queue.pushBack([counted]() { throw std::string("failed"); });
+	queue.pushBack([&runs]() { runs++; });
+	bool exceptionThrown = false;
+	try {
+		queue.runAll();
+	}
+	catch (std::string& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown && Counted::s_alive == 1 && queue.size() == 1);
+	AGREGATE_TEST_RESULT(testResult, queue.runAll() == 1 && runs == 1);
+
+	exceptionThrown = false;
+	try {
+		queue.popFront();
+	}
+	catch (TaskQueue::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+}
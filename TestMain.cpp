@@ -15,6 +15,95 @@ namespace QueueTests {
 	bool testModuleFunctions();
 	bool testExceptions();
 	bool testConstQueue();
+	bool testNonThrowingPop();
+	bool testTrivialAndGenericData();
+	bool testRandomAccess();
+	bool testBufferCache();
+	bool testReductions();
+	bool testSpliceAndSplit();
+	bool testSortAndMerge();
+}
+
+namespace WorkStealingPoolTests {
+	bool testChaseLevDeque();
+	bool testSubmitAndWait();
+	bool testParallelFunctions();
+	bool testParallelReductions();
+}
+
+namespace AsyncQueueTests {
+	bool testPop();
+	bool testPopBatch();
+	bool testRemoteProducer();
+}
+
+namespace ShardedQueueTests {
+	bool testSingleThread();
+	bool testPerProducerOrder();
+}
+
+namespace BatchingConsumerTests {
+	bool testFlushTriggers();
+	bool testRateLimit();
+}
+
+namespace BoundedQueueTests {
+	bool testDropPolicies();
+	bool testBlockPolicy();
+}
+
+namespace UniqueQueueTests {
+	bool testDeduplication();
+	bool testManyKeys();
+}
+
+namespace TimerWheelTests {
+	bool testExpiry();
+	bool testCancel();
+}
+
+namespace AtomicHealthPointsTests {
+	bool testClampedOperations();
+	bool testConcurrentDamage();
+}
+
+namespace HealthPointsPoolTests {
+	bool testTransitionEvents();
+}
+
+namespace HealthPointsIndexTests {
+	bool testOrderStatistics();
+	bool testAgainstLinearScan();
+}
+
+namespace CopyOnWriteQueueTests {
+	bool testSnapshots();
+	bool testReaderThread();
+}
+
+namespace SharedMemoryQueueTests {
+	bool testSingleProcess();
+	bool testTwoProcesses();
+}
+
+namespace CompressedQueueTests {
+	bool testRoundTrip();
+	bool testCompressionRatio();
+}
+
+namespace TaskQueueTests {
+	bool testRunInOrder();
+	bool testDestroyAndThrow();
+}
+
+namespace HealthPointsLoaderTests {
+	bool testParse();
+	bool testErrors();
+}
+
+namespace QueueTraceTests {
+	bool testRecordAndFlush();
+	bool testSamplingAndThreads();
 }
 
 std::function<bool()> testsList[] = {
@@ -26,7 +115,71 @@ std::function<bool()> testsList[] = {
 	QueueTests::testQueueMethods,
 	QueueTests::testModuleFunctions,
 	QueueTests::testExceptions,
-	QueueTests::testConstQueue
+	QueueTests::testConstQueue,
+
+	WorkStealingPoolTests::testChaseLevDeque,
+	WorkStealingPoolTests::testSubmitAndWait,
+	WorkStealingPoolTests::testParallelFunctions,
+
+	AsyncQueueTests::testPop,
+	AsyncQueueTests::testPopBatch,
+	AsyncQueueTests::testRemoteProducer,
+
+	QueueTests::testNonThrowingPop,
+
+	ShardedQueueTests::testSingleThread,
+	ShardedQueueTests::testPerProducerOrder,
+
+	BatchingConsumerTests::testFlushTriggers,
+	BatchingConsumerTests::testRateLimit,
+
+	BoundedQueueTests::testDropPolicies,
+	BoundedQueueTests::testBlockPolicy,
+
+	QueueTests::testTrivialAndGenericData,
+	QueueTests::testRandomAccess,
+
+	UniqueQueueTests::testDeduplication,
+	UniqueQueueTests::testManyKeys,
+
+	TimerWheelTests::testExpiry,
+	TimerWheelTests::testCancel,
+
+	AtomicHealthPointsTests::testClampedOperations,
+	AtomicHealthPointsTests::testConcurrentDamage,
+
+	HealthPointsPoolTests::testTransitionEvents,
+
+	HealthPointsIndexTests::testOrderStatistics,
+	HealthPointsIndexTests::testAgainstLinearScan,
+
+	QueueTests::testBufferCache,
+
+	CopyOnWriteQueueTests::testSnapshots,
+	CopyOnWriteQueueTests::testReaderThread,
+
+	SharedMemoryQueueTests::testSingleProcess,
+	SharedMemoryQueueTests::testTwoProcesses,
+
+	QueueTests::testReductions,
+
+	WorkStealingPoolTests::testParallelReductions,
+
+	CompressedQueueTests::testRoundTrip,
+	CompressedQueueTests::testCompressionRatio,
+
+	QueueTests::testSpliceAndSplit,
+
+	TaskQueueTests::testRunInOrder,
+	TaskQueueTests::testDestroyAndThrow,
+
+	HealthPointsLoaderTests::testParse,
+	HealthPointsLoaderTests::testErrors,
+
+	QueueTests::testSortAndMerge,
+
+	QueueTraceTests::testRecordAndFlush,
+	QueueTraceTests::testSamplingAndThreads
 };
 
 const int NUMBER_OF_TESTS = sizeof(testsList)/sizeof(std::function<bool()>);
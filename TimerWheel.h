@@ -0,0 +1,266 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <utility>
+
+#include "Queue.h"
+
+
+/*
+ * TimerWheel - Hierarchical timing wheel of tasks scheduled for a deadline, measured in ticks.
+ * The wheel has LEVELS levels of SLOTS_PER_LEVEL slots, and every slot is a Queue<Timer> bucket.
+ * A timer due within SLOTS_PER_LEVEL ticks goes straight to its slot in the first level, later timers go to
+ * a coarser level, and are moved down ("cascaded") when the lower level wraps around.
+ *
+ * schedule and cancel are O(1). popExpired does O(1) work per tick it advances over, plus the work of moving
+ * each timer down at most LEVELS - 1 times in its lifetime. A cancelled timer stays in its bucket until the
+ * wheel reaches it, and is then dropped.
+*/
+template <class T>
+class TimerWheel {
+
+public:
+
+    typedef long long Tick;
+
+    static const int SLOT_BITS = 6;
+    static const int SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+
+    /*
+     * TimerId - handle of a scheduled timer, used to cancel it.
+    */
+    struct TimerId {
+        int m_handle;
+        unsigned m_generation;
+    };
+
+    /*
+     * C'tor for TimerWheel class.
+     *
+     * @param currentTick - the first tick popExpired will process.
+     * @return
+     * A new instance of TimerWheel.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    explicit TimerWheel(Tick currentTick = 0);
+
+    /*
+     * D'tor for TimerWheel class.
+    */
+    ~TimerWheel() = default;
+
+    /*
+     * The buckets hold handles into the wheel's own tables, so copying is not allowed.
+    */
+    TimerWheel(const TimerWheel& wheel) = delete;
+    TimerWheel& operator=(const TimerWheel& otherWheel) = delete;
+
+    /*
+     * schedule - Schedules a task for the given deadline.
+     *
+     * @param deadline - the tick the task expires at. A deadline that already passed expires on the next tick.
+     * @param task - the task to schedule.
+     * @return
+     * Returns a TimerId to cancel the timer with.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the assignment of T.
+    */
+    TimerId schedule(Tick deadline, const T& task);
+
+    /*
+     * cancel - Cancels a timer that did not expire yet.
+     *
+     * @param timerId - the timer to cancel.
+     * @return
+     * Returns true if the timer was cancelled, false if it already expired or was cancelled.
+    */
+    bool cancel(TimerId timerId);
+
+    /*
+     * popExpired - Advances the wheel up to and including now, and moves the tasks of every timer
+     * that expired on the way to the end of out, in deadline order.
+     *
+     * @param now - the current tick.
+     * @param out - receives the expired tasks.
+     * @return
+     * Returns the number of expired tasks.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the task that was being moved to out is lost.
+    */
+    int popExpired(Tick now, Queue<T>& out);
+
+    /*
+     * size - the number of timers that did not expire and were not cancelled.
+    */
+    int size() const;
+
+    /*
+     * currentTick - the next tick popExpired will process.
+    */
+    Tick currentTick() const;
+
+private:
+
+    /*
+     * Timer - a bucket entry. The timer is alive while the generation of its handle did not change.
+    */
+    struct Timer {
+        Tick m_deadline;
+        int m_handle;
+        unsigned m_generation;
+        T m_task;
+    };
+
+    Queue<Timer> m_buckets[LEVELS][SLOTS_PER_LEVEL];
+    Queue<unsigned> m_generations;
+    Queue<int> m_freeHandles;
+    Tick m_currentTick;
+    int m_size;
+
+    /*
+     * insert - puts the timer in the bucket of its deadline, relative to the current tick.
+    */
+    void insert(const Timer& timer);
+
+    /*
+     * cascade - moves the timers of the current bucket of the level down to the lower levels.
+     *
+     * @return
+     * Returns true if the level wrapped around as well, so the level above it must be cascaded too.
+    */
+    bool cascade(int level);
+
+    /*
+     * isAlive - checks if the timer was not cancelled.
+    */
+    bool isAlive(const Timer& timer) const;
+
+    /*
+     * releaseHandle - frees the handle of a live timer, so its TimerId and bucket entry become stale.
+    */
+    void releaseHandle(int handle);
+};
+
+
+/* ------------------------------------ Public Functions of TimerWheel Class ------------------------------------*/
+
+template <class T>
+TimerWheel<T>::TimerWheel(Tick currentTick) : m_generations(), m_freeHandles(), m_currentTick(currentTick),
+    m_size(0) {}
+
+template <class T>
+typename TimerWheel<T>::TimerId TimerWheel<T>::schedule(Tick deadline, const T& task){
+    if(m_freeHandles.size() == 0){
+        m_generations.pushBack(0);
+        m_freeHandles.pushBack(m_generations.size() - 1);
+    }
+    Timer timer;
+    timer.m_deadline = deadline < m_currentTick ? m_currentTick : deadline;
+    timer.m_handle = m_freeHandles.front();
+    timer.m_generation = m_generations[timer.m_handle];
+    timer.m_task = task;
+    insert(timer);
+    m_freeHandles.popFront();
+    m_size++;
+    return TimerId{ timer.m_handle, timer.m_generation };
+}
+
+template <class T>
+bool TimerWheel<T>::cancel(TimerId timerId){
+    if(timerId.m_handle < 0 || timerId.m_handle >= m_generations.size() ||
+       m_generations[timerId.m_handle] != timerId.m_generation){
+        return false;
+    }
+    releaseHandle(timerId.m_handle);
+    return true;
+}
+
+template <class T>
+int TimerWheel<T>::popExpired(Tick now, Queue<T>& out){
+    int expired = 0;
+    Timer timer;
+    for( ; m_currentTick <= now ; m_currentTick++){
+        if(m_size == 0){
+            /* Only stale entries of cancelled timers are left, so the wheel may skip ahead */
+            m_currentTick = now + 1;
+            break;
+        }
+        int slot = static_cast<int>(m_currentTick & (SLOTS_PER_LEVEL - 1));
+        if(slot == 0){
+            for(int level = 1 ; level < LEVELS && cascade(level) ; level++){}
+        }
+        Queue<Timer>& bucket = m_buckets[0][slot];
+        while(bucket.popFrontInto(timer)){
+            if(isAlive(timer)){
+                releaseHandle(timer.m_handle);
+                out.pushBack(std::move(timer.m_task));
+                expired++;
+            }
+        }
+    }
+    return expired;
+}
+
+template <class T>
+int TimerWheel<T>::size() const{
+    return m_size;
+}
+
+template <class T>
+typename TimerWheel<T>::Tick TimerWheel<T>::currentTick() const{
+    return m_currentTick;
+}
+
+/* --------------------------------- End of Public Functions of TimerWheel Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of TimerWheel Class ------------------------------------*/
+
+template <class T>
+void TimerWheel<T>::insert(const Timer& timer){
+    Tick delta = timer.m_deadline - m_currentTick;
+    for(int level = 0 ; level < LEVELS ; level++){
+        int shift = level * SLOT_BITS;
+        if(delta < (static_cast<Tick>(SLOTS_PER_LEVEL) << shift) || level == LEVELS - 1){
+            /* Timers beyond the range of the wheel wait in the farthest slot of the top level and are re-inserted */
+            Tick deadline = level == LEVELS - 1 && delta >= (static_cast<Tick>(SLOTS_PER_LEVEL) << shift) ?
+                m_currentTick + ((static_cast<Tick>(SLOTS_PER_LEVEL) - 1) << shift) : timer.m_deadline;
+            m_buckets[level][(deadline >> shift) & (SLOTS_PER_LEVEL - 1)].pushBack(timer);
+            return;
+        }
+    }
+}
+
+template <class T>
+bool TimerWheel<T>::cascade(int level){
+    int slot = static_cast<int>((m_currentTick >> (level * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1));
+    Queue<Timer>& bucket = m_buckets[level][slot];
+    /* Timers beyond the range of the wheel may go back to this bucket, so only the current ones are moved */
+    Timer timer;
+    for(int i = bucket.size() ; i > 0 && bucket.popFrontInto(timer) ; i--){
+        if(isAlive(timer)){
+            insert(timer);
+        }
+    }
+    return slot == 0;
+}
+
+template <class T>
+bool TimerWheel<T>::isAlive(const Timer& timer) const{
+    return m_generations[timer.m_handle] == timer.m_generation;
+}
+
+template <class T>
+void TimerWheel<T>::releaseHandle(int handle){
+    m_freeHandles.pushBack(handle);
+    m_generations[handle]++;
+    m_size--;
+}
+
+/* -------------------------------- End of Private Functions of TimerWheel Class --------------------------------*/
+
+#endif //TIMER_WHEEL_H
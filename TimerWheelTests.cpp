@@ -0,0 +1,94 @@
+#include "TimerWheel.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace TimerWheelTests {
+
+typedef TimerWheel<long long> Wheel;
+
+bool testExpiry()
+{
+	bool testResult = true;
+
+	Wheel wheel(100);
+	Queue<long long> expired;
+	/* deadlines on every level, past the range of the wheel, and one that already passed */
+	long long deadlines[] = { 100, 163, 164, 5000, 300000, 20000000, 40000000, 50 };
+	for (long long deadline : deadlines) {
+		wheel.schedule(deadline, deadline);
+	}
+	AGREGATE_TEST_RESULT(testResult, wheel.size() == 8);
+
+	AGREGATE_TEST_RESULT(testResult, wheel.popExpired(100, expired) == 2);
+	AGREGATE_TEST_RESULT(testResult, expired.size() == 2 && expired.front() == 100);
+	expired.popFront();
+	AGREGATE_TEST_RESULT(testResult, expired.front() == 50);
+	expired.popFront();
+
+	long long checkpoints[] = { 162, 163, 164, 4999, 5000, 299999, 300000, 19999999, 20000000, 40000000 };
+	int expectedCounts[] = { 0, 1, 1, 0, 1, 0, 1, 0, 1, 1 };
+	for (int i = 0; i < 10; i++) {
+		int count = wheel.popExpired(checkpoints[i], expired);
+		AGREGATE_TEST_RESULT(testResult, count == expectedCounts[i]);
+		if (count == 1) {
+			AGREGATE_TEST_RESULT(testResult, expired.front() == checkpoints[i]);
+			expired.popFront();
+		}
+	}
+	AGREGATE_TEST_RESULT(testResult, wheel.size() == 0 && wheel.currentTick() == 40000001);
+
+	/* deadlines in random order against a plain count */
+	unsigned state = 12345;
+	int dueBy[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 5000; i++) {
+		state = state * 1103515245u + 12345u;
+		long long delay = (state >> 8) % 300000;
+		wheel.schedule(wheel.currentTick() + delay, wheel.currentTick() + delay);
+		dueBy[delay / 75000]++;
+	}
+	long long previous = 0;
+	for (int quarter = 0; quarter < 4; quarter++) {
+		int count = wheel.popExpired(40000001 + (quarter + 1) * 75000 - 1, expired);
+		AGREGATE_TEST_RESULT(testResult, count == dueBy[quarter]);
+		long long deadline;
+		while (expired.popFrontInto(deadline)) {
+			AGREGATE_TEST_RESULT(testResult, deadline >= previous);
+			previous = deadline;
+		}
+	}
+
+	return testResult;
+}
+
+bool testCancel()
+{
+	bool testResult = true;
+
+	Wheel wheel;
+	Queue<long long> expired;
+	Wheel::TimerId first = wheel.schedule(10, 1);
+	Wheel::TimerId second = wheel.schedule(10000, 2);
+	Wheel::TimerId third = wheel.schedule(10000, 3);
+	AGREGATE_TEST_RESULT(testResult, wheel.cancel(second) && !wheel.cancel(second));
+	AGREGATE_TEST_RESULT(testResult, wheel.size() == 2);
+
+	AGREGATE_TEST_RESULT(testResult, wheel.popExpired(10, expired) == 1 && !wheel.cancel(first));
+
+	/* the handle of a cancelled timer is reused, its old id must stay stale */
+	Wheel::TimerId fourth = wheel.schedule(20, 4);
+	AGREGATE_TEST_RESULT(testResult, fourth.m_handle == second.m_handle || fourth.m_handle == first.m_handle);
+	AGREGATE_TEST_RESULT(testResult, !wheel.cancel(second) && !wheel.cancel(first));
+
+	AGREGATE_TEST_RESULT(testResult, wheel.popExpired(20000, expired) == 2);
+	AGREGATE_TEST_RESULT(testResult, expired.size() == 3);
+	long long expectedTasks[] = { 1, 4, 3 };
+	int i = 0;
+	for (long long task : expired) {
+		AGREGATE_TEST_RESULT(testResult, task == expectedTasks[i++]);
+	}
+	AGREGATE_TEST_RESULT(testResult, !wheel.cancel(third) && wheel.size() == 0);
+
+	return testResult;
+}
+
+}
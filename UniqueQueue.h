@@ -0,0 +1,455 @@
+#ifndef UNIQUE_QUEUE_H
+#define UNIQUE_QUEUE_H
+
+#include <functional>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Queue.h"
+
+
+/*
+ * UniqueQueue - Queue of key-value entries that holds every key at most once.
+ * The entries are kept in the order their key was first pushed. Pushing a key that is already in the queue
+ * replaces its value (or merges the two values) in place, so the consumer sees a single, up to date entry.
+ *
+ * The entries live in a Queue<Entry>. Each entry is numbered by the order of its insertion, so its place in
+ * the queue is its number minus the number of pops. An open addressing hash table with linear probing maps
+ * every key to that number, which makes pushBack, popFront and contains O(1) on average.
+*/
+template <class K, class V, class Hash = std::hash<K>>
+class UniqueQueue {
+
+public:
+
+    /*
+     * Entry - a key and its latest value.
+    */
+    struct Entry {
+        K m_key;
+        V m_value;
+    };
+
+    typedef typename Queue<Entry>::ConstIterator ConstIterator;
+
+    /*
+     * C'tor for UniqueQueue class.
+     *
+     * @return
+     * A new instance of UniqueQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    UniqueQueue();
+
+    /*
+     * D'tor for UniqueQueue class.
+    */
+    ~UniqueQueue();
+
+    /*
+     * Copy C'tor for UniqueQueue class.
+     *
+     * @param queue - The queue to copy.
+     * @return
+     * A new instance of UniqueQueue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    UniqueQueue(const UniqueQueue& queue);
+
+    /*
+     * Assignment operator for UniqueQueue class.
+     *
+     * @param otherQueue - The queue to assign.
+     * @return
+     * Reference to the updated queue.
+     * @exception
+     * std::bad_alloc exception might be thrown, in which case the queue is unchanged.
+    */
+    UniqueQueue& operator=(const UniqueQueue& otherQueue);
+
+    /*
+     * swap - Exchanges the entries of the queue and of other, O(1).
+     *
+     * @param other - the queue to exchange entries with.
+    */
+    void swap(UniqueQueue& other) noexcept(std::is_nothrow_swappable<Hash>::value);
+
+    /*
+     * pushBack - Inserts a new entry at the end of the queue, or replaces the value of the key if it is
+     * already in the queue. A replaced entry keeps its place.
+     *
+     * @param key - the key of the entry.
+     * @param value - the value of the entry.
+     * @return
+     * Returns true if the key was inserted, false if its value was replaced.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the hash or the assignment of K and V.
+    */
+    bool pushBack(const K& key, const V& value);
+
+    /*
+     * pushBack - Inserts a new entry at the end of the queue, or merges value into the value of the key
+     * if it is already in the queue. A merged entry keeps its place.
+     *
+     * @param key - the key of the entry.
+     * @param value - the value of the entry.
+     * @param merge - called as merge(V& existingValue, const V& value) when the key is already in the queue.
+     * @return
+     * Returns true if the key was inserted, false if its value was merged.
+     * @exception
+     * std::bad_alloc exception might be thrown,
+     * as well as, a random exception might be thrown by the hash, merge or the assignment of K and V.
+    */
+    template <class Merge>
+    bool pushBack(const K& key, const V& value, const Merge& merge);
+
+    /*
+     * front - Returns the first entry in the queue.
+     *
+     * @return
+     * Returns the first entry.
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    const Entry& front() const;
+
+    /*
+     * popFront - Removes the first entry in the queue.
+     *
+     * @exception
+     * EmptyQueue exception, in case the queue is empty.
+    */
+    void popFront();
+
+    /*
+     * popFrontInto - Moves the first entry in the queue into destination and removes it.
+     *
+     * @param destination - receives the first entry.
+     * @return
+     * Returns true if an entry was removed, false if the queue is empty.
+    */
+    bool popFrontInto(Entry& destination);
+
+    /*
+     * tryPopFront - Removes the first entry in the queue and returns it.
+     *
+     * @return
+     * Returns the removed entry, or an empty optional if the queue is empty.
+    */
+    std::optional<Entry> tryPopFront();
+
+    /*
+     * contains - checks if the key is in the queue.
+     *
+     * @param key - the key to look for.
+     * @return
+     * Returns true if the key is in the queue, else false.
+    */
+    bool contains(const K& key) const;
+
+    /*
+     * find - the value of the key.
+     *
+     * @param key - the key to look for.
+     * @return
+     * Returns a pointer to the value of the key, or nullptr if the key is not in the queue.
+    */
+    const V* find(const K& key) const;
+
+    /*
+     * size - the number of entries in the queue.
+    */
+    int size() const;
+
+    /*
+     * begin - begin iterator, over the entries in queue order.
+    */
+    ConstIterator begin() const;
+
+    /*
+     * end - end iterator
+    */
+    ConstIterator end() const;
+
+    /*
+     * EmptyQueue - Exception for invalid operations on empty queue
+    */
+    class EmptyQueue {};
+
+private:
+
+    static const long long EMPTY_SLOT = -1;
+    static const int INITIAL_NUMBER_OF_SLOTS = 16;
+
+    Queue<Entry> m_entries;
+    long long m_numberOfPops;
+    long long* m_slots;
+    int m_numberOfSlots;
+    Hash m_hash;
+
+    /*
+     * homeSlot - the slot the key is hashed to.
+    */
+    int homeSlot(const K& key) const;
+
+    /*
+     * entryOf - the entry a used slot points to.
+    */
+    const Entry& entryOf(long long sequence) const;
+
+    /*
+     * findSlot - the slot that points to the entry of the key, or -1 if the key is not in the queue.
+    */
+    int findSlot(const K& key) const;
+
+    /*
+     * insertSlot - points the first free slot from the key's home slot to the entry with the given sequence.
+     * There must be a free slot.
+    */
+    void insertSlot(const K& key, long long sequence);
+
+    /*
+     * eraseSlot - frees the slot, shifting back the following slots of its probe sequence
+     * so that lookups do not need tombstones.
+    */
+    void eraseSlot(int slot);
+
+    /*
+     * rehash - rebuilds the table with the given number of slots, a power of two.
+    */
+    void rehash(int numberOfSlots);
+
+    /*
+     * insertEntry - common part of both pushBack functions, for a key that is not in the queue.
+    */
+    void insertEntry(const K& key, const V& value);
+};
+
+
+/* ------------------------------------ Public Functions of UniqueQueue Class ------------------------------------*/
+
+template <class K, class V, class Hash>
+UniqueQueue<K, V, Hash>::UniqueQueue() : m_entries(), m_numberOfPops(0), m_slots(nullptr),
+    m_numberOfSlots(INITIAL_NUMBER_OF_SLOTS), m_hash() {
+    m_slots = new long long[m_numberOfSlots];
+    for(int i = 0 ; i < m_numberOfSlots ; i++){
+        m_slots[i] = EMPTY_SLOT;
+    }
+}
+
+template <class K, class V, class Hash>
+UniqueQueue<K, V, Hash>::~UniqueQueue(){
+    delete[] m_slots;
+}
+
+template <class K, class V, class Hash>
+UniqueQueue<K, V, Hash>::UniqueQueue(const UniqueQueue& queue) : m_entries(queue.m_entries),
+    m_numberOfPops(queue.m_numberOfPops), m_slots(nullptr), m_numberOfSlots(queue.m_numberOfSlots),
+    m_hash(queue.m_hash) {
+    m_slots = new long long[m_numberOfSlots];
+    for(int i = 0 ; i < m_numberOfSlots ; i++){
+        m_slots[i] = queue.m_slots[i];
+    }
+}
+
+template <class K, class V, class Hash>
+UniqueQueue<K, V, Hash>& UniqueQueue<K, V, Hash>::operator=(const UniqueQueue& otherQueue){
+    if(this == &otherQueue){
+        return *this;
+    }
+    UniqueQueue copy(otherQueue);
+    swap(copy);
+    return *this;
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::swap(UniqueQueue& other) noexcept(std::is_nothrow_swappable<Hash>::value){
+    m_entries.swap(other.m_entries);
+    std::swap(m_numberOfPops, other.m_numberOfPops);
+    std::swap(m_slots, other.m_slots);
+    std::swap(m_numberOfSlots, other.m_numberOfSlots);
+    std::swap(m_hash, other.m_hash);
+}
+
+template <class K, class V, class Hash>
+bool UniqueQueue<K, V, Hash>::pushBack(const K& key, const V& value){
+    int slot = findSlot(key);
+    if(slot != -1){
+        m_entries[static_cast<int>(m_slots[slot] - m_numberOfPops)].m_value = value;
+        return false;
+    }
+    insertEntry(key, value);
+    return true;
+}
+
+template <class K, class V, class Hash>
+template <class Merge>
+bool UniqueQueue<K, V, Hash>::pushBack(const K& key, const V& value, const Merge& merge){
+    int slot = findSlot(key);
+    if(slot != -1){
+        merge(m_entries[static_cast<int>(m_slots[slot] - m_numberOfPops)].m_value, value);
+        return false;
+    }
+    insertEntry(key, value);
+    return true;
+}
+
+template <class K, class V, class Hash>
+const typename UniqueQueue<K, V, Hash>::Entry& UniqueQueue<K, V, Hash>::front() const{
+    if(m_entries.size() == 0){
+        throw EmptyQueue();
+    }
+    return m_entries.front();
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::popFront(){
+    if(m_entries.size() == 0){
+        throw EmptyQueue();
+    }
+    eraseSlot(findSlot(m_entries.front().m_key));
+    m_entries.popFront();
+    m_numberOfPops++;
+}
+
+template <class K, class V, class Hash>
+bool UniqueQueue<K, V, Hash>::popFrontInto(Entry& destination){
+    if(m_entries.size() == 0){
+        return false;
+    }
+    eraseSlot(findSlot(m_entries.front().m_key));
+    m_entries.popFrontInto(destination);
+    m_numberOfPops++;
+    return true;
+}
+
+template <class K, class V, class Hash>
+std::optional<typename UniqueQueue<K, V, Hash>::Entry> UniqueQueue<K, V, Hash>::tryPopFront(){
+    Entry result;
+    if(!popFrontInto(result)){
+        return std::nullopt;
+    }
+    return std::optional<Entry>(std::move(result));
+}
+
+template <class K, class V, class Hash>
+bool UniqueQueue<K, V, Hash>::contains(const K& key) const{
+    return findSlot(key) != -1;
+}
+
+template <class K, class V, class Hash>
+const V* UniqueQueue<K, V, Hash>::find(const K& key) const{
+    int slot = findSlot(key);
+    if(slot == -1){
+        return nullptr;
+    }
+    return &entryOf(m_slots[slot]).m_value;
+}
+
+template <class K, class V, class Hash>
+int UniqueQueue<K, V, Hash>::size() const{
+    return m_entries.size();
+}
+
+template <class K, class V, class Hash>
+typename UniqueQueue<K, V, Hash>::ConstIterator UniqueQueue<K, V, Hash>::begin() const{
+    return m_entries.begin();
+}
+
+template <class K, class V, class Hash>
+typename UniqueQueue<K, V, Hash>::ConstIterator UniqueQueue<K, V, Hash>::end() const{
+    return m_entries.end();
+}
+
+/* --------------------------------- End of Public Functions of UniqueQueue Class ---------------------------------*/
+
+/* ------------------------------------ ------------------------------------- ------------------------------------*/
+
+/* ------------------------------------ Private Functions of UniqueQueue Class ------------------------------------*/
+
+template <class K, class V, class Hash>
+int UniqueQueue<K, V, Hash>::homeSlot(const K& key) const{
+    /* Fibonacci hashing spreads poor hashes, such as the identity hash of integers, over the table */
+    unsigned long long hash = static_cast<unsigned long long>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<int>((hash >> 32) & static_cast<unsigned long long>(m_numberOfSlots - 1));
+}
+
+template <class K, class V, class Hash>
+const typename UniqueQueue<K, V, Hash>::Entry& UniqueQueue<K, V, Hash>::entryOf(long long sequence) const{
+    return m_entries[static_cast<int>(sequence - m_numberOfPops)];
+}
+
+template <class K, class V, class Hash>
+int UniqueQueue<K, V, Hash>::findSlot(const K& key) const{
+    int mask = m_numberOfSlots - 1;
+    for(int slot = homeSlot(key) ; m_slots[slot] != EMPTY_SLOT ; slot = (slot + 1) & mask){
+        if(entryOf(m_slots[slot]).m_key == key){
+            return slot;
+        }
+    }
+    return -1;
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::insertSlot(const K& key, long long sequence){
+    int mask = m_numberOfSlots - 1;
+    int slot = homeSlot(key);
+    while(m_slots[slot] != EMPTY_SLOT){
+        slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = sequence;
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::eraseSlot(int slot){
+    int mask = m_numberOfSlots - 1;
+    int next = slot;
+    while(true){
+        next = (next + 1) & mask;
+        if(m_slots[next] == EMPTY_SLOT){
+            break;
+        }
+        /* The entry at next may move back to slot only if its home slot is not between them */
+        int home = homeSlot(entryOf(m_slots[next]).m_key);
+        bool homeBetween = slot <= next ? (slot < home && home <= next) : (slot < home || home <= next);
+        if(!homeBetween){
+            m_slots[slot] = m_slots[next];
+            slot = next;
+        }
+    }
+    m_slots[slot] = EMPTY_SLOT;
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::rehash(int numberOfSlots){
+    long long* slots = new long long[numberOfSlots];
+    for(int i = 0 ; i < numberOfSlots ; i++){
+        slots[i] = EMPTY_SLOT;
+    }
+    delete[] m_slots;
+    m_slots = slots;
+    m_numberOfSlots = numberOfSlots;
+    for(int i = 0 ; i < m_entries.size() ; i++){
+        insertSlot(m_entries[i].m_key, m_numberOfPops + i);
+    }
+}
+
+template <class K, class V, class Hash>
+void UniqueQueue<K, V, Hash>::insertEntry(const K& key, const V& value){
+    /* The table is kept at most half full, so probe sequences stay short */
+    if((m_entries.size() + 1) * 2 > m_numberOfSlots){
+        rehash(m_numberOfSlots * 2);
+    }
+    Entry entry = { key, value };
+    m_entries.pushBack(entry);
+    insertSlot(key, m_numberOfPops + m_entries.size() - 1);
+}
+
+/* -------------------------------- End of Private Functions of UniqueQueue Class --------------------------------*/
+
+#endif //UNIQUE_QUEUE_H
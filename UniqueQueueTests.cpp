@@ -0,0 +1,91 @@
+#include <string>
+
+#include "UniqueQueue.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+namespace UniqueQueueTests {
+
+bool testDeduplication()
+{
+	bool testResult = true;
+
+	UniqueQueue<std::string, int> queue;
+	AGREGATE_TEST_RESULT(testResult, queue.pushBack("a", 1));
+	AGREGATE_TEST_RESULT(testResult, queue.pushBack("b", 2));
+	AGREGATE_TEST_RESULT(testResult, !queue.pushBack("a", 3));
+	AGREGATE_TEST_RESULT(testResult, queue.pushBack("c", 4));
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 3 && queue.contains("a") && !queue.contains("d"));
+	AGREGATE_TEST_RESULT(testResult, queue.front().m_key == "a" && queue.front().m_value == 3);
+
+	queue.pushBack("b", 10, [](int& existing, const int& value) { existing += value; });
+	AGREGATE_TEST_RESULT(testResult, queue.find("b") && *queue.find("b") == 12 && !queue.find("d"));
+
+	const char* expectedKeys[] = { "a", "b", "c" };
+	int i = 0;
+	for (const UniqueQueue<std::string, int>::Entry& entry : queue) {
+		AGREGATE_TEST_RESULT(testResult, entry.m_key == expectedKeys[i++]);
+	}
+
+	queue.popFront();
+	AGREGATE_TEST_RESULT(testResult, !queue.contains("a") && queue.contains("b"));
+	AGREGATE_TEST_RESULT(testResult, queue.pushBack("a", 5));
+	std::optional<UniqueQueue<std::string, int>::Entry> entry = queue.tryPopFront();
+	AGREGATE_TEST_RESULT(testResult, entry && entry->m_key == "b" && entry->m_value == 12);
+	queue.popFront();
+	queue.popFront();
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 0 && !queue.tryPopFront());
+
+	bool exceptionThrown = false;
+	try {
+		queue.front();
+	}
+	catch (UniqueQueue<std::string, int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testManyKeys()
+{
+	bool testResult = true;
+
+	/* Keys that collide on the low bits, interleaved pushes and pops, and growth of the table */
+	UniqueQueue<int, int> queue;
+	int nextToPop = 0;
+	for (int round = 0; round < 4; round++) {
+		for (int key = 0; key < 1000; key++) {
+			queue.pushBack(key * 1024, round);
+		}
+		for (int j = 0; j < 300; j++) {
+			UniqueQueue<int, int>::Entry entry;
+			queue.popFrontInto(entry);
+			AGREGATE_TEST_RESULT(testResult, entry.m_key == nextToPop * 1024);
+			nextToPop = (nextToPop + 1) % 1000;
+		}
+	}
+	AGREGATE_TEST_RESULT(testResult, queue.size() == 1000 - 300);
+	for (int key = 0; key < 1000; key++) {
+		bool popped = key < 200 || key >= 900;
+		AGREGATE_TEST_RESULT(testResult, queue.contains(key * 1024) != popped);
+	}
+
+	UniqueQueue<int, int> copy = queue;
+	copy.pushBack(5000 * 1024, 0);
+	AGREGATE_TEST_RESULT(testResult, copy.size() == queue.size() + 1 && !queue.contains(5000 * 1024));
+	AGREGATE_TEST_RESULT(testResult, copy.front().m_key == 200 * 1024 && *copy.find(899 * 1024) == 3);
+
+	UniqueQueue<int, int> assigned;
+	assigned.pushBack(7, 7);
+	assigned = copy;
+	AGREGATE_TEST_RESULT(testResult, assigned.size() == copy.size() && !assigned.contains(7));
+	AGREGATE_TEST_RESULT(testResult, assigned.contains(5000 * 1024) && assigned.front().m_key == 200 * 1024);
+	assigned.swap(queue);
+	AGREGATE_TEST_RESULT(testResult, queue.contains(5000 * 1024) && !assigned.contains(5000 * 1024));
+
+	return testResult;
+}
+
+}
@@ -0,0 +1,171 @@
+#include "WorkStealingPool.h"
+
+#include <chrono>
+
+
+thread_local WorkStealingPool* WorkStealingPool::t_currentPool = nullptr;
+thread_local int WorkStealingPool::t_currentWorker = -1;
+
+/* How long an idle worker sleeps before looking for work again, in case a wake up was missed */
+static const std::chrono::milliseconds IDLE_TIMEOUT(10);
+
+
+WorkStealingPool::WorkStealingPool(int numberOfWorkers) : m_workers(nullptr),
+    m_numberOfWorkers(numberOfWorkers > 0 ? numberOfWorkers : 1), m_queuedTasks(0), m_unfinishedTasks(0),
+    m_sleepers(0), m_stop(false) {
+
+    m_workers = new Worker[m_numberOfWorkers];
+    int started = 0;
+    try{
+        for( ; started < m_numberOfWorkers ; started++){
+            m_workers[started].m_thread = std::thread(&WorkStealingPool::workerLoop, this, started);
+        }
+    } catch(...){
+        m_stop = true;
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeUp.notify_all();
+        for(int i = 0 ; i < started ; i++){
+            m_workers[i].m_thread.join();
+        }
+        delete[] m_workers;
+        throw;
+    }
+}
+
+WorkStealingPool::~WorkStealingPool(){
+    try{
+        wait();
+    } catch(...) {}
+
+    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeUp.notify_all();
+    for(int i = 0 ; i < m_numberOfWorkers ; i++){
+        m_workers[i].m_thread.join();
+    }
+    delete[] m_workers;
+}
+
+void WorkStealingPool::wait(){
+    int workerIndex = (t_currentPool == this) ? t_currentWorker : -1;
+    while(m_unfinishedTasks.load() > 0){
+        Task* task = nullptr;
+        if(findTask(workerIndex, task)){
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_allDone.wait_for(lock, IDLE_TIMEOUT, [this]() { return m_unfinishedTasks.load() == 0; });
+    }
+
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    if(m_error){
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+int WorkStealingPool::numberOfWorkers() const{
+    return m_numberOfWorkers;
+}
+
+int WorkStealingPool::defaultNumberOfWorkers(){
+    int hardwareConcurrency = static_cast<int>(std::thread::hardware_concurrency());
+    return hardwareConcurrency > 0 ? hardwareConcurrency : 1;
+}
+
+void WorkStealingPool::schedule(Task* task){
+    m_unfinishedTasks++;
+    m_queuedTasks++;
+    try{
+        if(t_currentPool == this){
+            m_workers[t_currentWorker].m_deque.pushBack(task);
+        }
+        else{
+            std::lock_guard<std::mutex> lock(m_injectionMutex);
+            m_injectionQueue.pushBack(task);
+        }
+    } catch(...){
+        m_queuedTasks--;
+        m_unfinishedTasks--;
+        throw;
+    }
+
+    /* m_queuedTasks and m_sleepers are both sequentially consistent, so either we see the sleeper or it sees the task */
+    if(m_sleepers.load() > 0){
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeUp.notify_one();
+    }
+}
+
+bool WorkStealingPool::findTask(int workerIndex, Task*& task){
+    if(workerIndex >= 0 && m_workers[workerIndex].m_deque.popBack(task)){
+        m_queuedTasks--;
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_injectionMutex);
+        if(m_injectionQueue.popFrontInto(task)){
+            m_queuedTasks--;
+            return true;
+        }
+    }
+
+    int firstVictim = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for(int i = 0 ; i < m_numberOfWorkers ; i++){
+        int victim = (firstVictim + i) % m_numberOfWorkers;
+        if(victim != workerIndex && m_workers[victim].m_deque.stealFront(task)){
+            m_queuedTasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::runTask(Task* task){
+    try{
+        (*task)();
+    } catch(...){
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        if(!m_error){
+            m_error = std::current_exception();
+        }
+    }
+    delete task;
+
+    if(--m_unfinishedTasks == 0){
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_allDone.notify_all();
+    }
+}
+
+void WorkStealingPool::workerLoop(int workerIndex){
+    t_currentPool = this;
+    t_currentWorker = workerIndex;
+
+    while(true){
+        Task* task = nullptr;
+        if(findTask(workerIndex, task)){
+            runTask(task);
+            continue;
+        }
+        if(m_stop.load()){
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers++;
+        m_wakeUp.wait_for(lock, IDLE_TIMEOUT, [this]() { return m_stop.load() || m_queuedTasks.load() > 0; });
+        m_sleepers--;
+    }
+}
@@ -0,0 +1,409 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ChaseLevDeque.h"
+#include "Queue.h"
+
+
+/*
+ * WorkStealingPool - Thread pool in which every worker owns a ChaseLevDeque.
+ * Tasks submitted from a worker go to the back of its own deque, tasks submitted
+ * from any other thread go to a shared injection queue. Idle workers steal from the front
+ * of the other deques.
+*/
+class WorkStealingPool {
+
+public:
+
+    /*
+     * C'tor for WorkStealingPool class.
+     *
+     * @param numberOfWorkers - number of worker threads, the hardware concurrency by default.
+     * @return
+     * A new instance of WorkStealingPool with running workers.
+     * @exception
+     * std::bad_alloc or std::system_error exception might be thrown.
+    */
+    explicit WorkStealingPool(int numberOfWorkers = defaultNumberOfWorkers());
+
+    /*
+     * D'tor for WorkStealingPool class.
+     * Runs every task already submitted, then stops and joins the workers.
+    */
+    ~WorkStealingPool();
+
+    /*
+     * The workers hold the address of the pool, so copying is not allowed.
+    */
+    WorkStealingPool(const WorkStealingPool& pool) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool& otherPool) = delete;
+
+    /*
+     * submit - Schedules a task on the pool.
+     *
+     * @param function - any copyable callable that takes no arguments.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    template <class Function>
+    void submit(const Function& function);
+
+    /*
+     * wait - Blocks until every submitted task has finished. The calling thread runs tasks while waiting.
+     * Must not be called from inside a task, since that task would wait for itself.
+     *
+     * @exception
+     * Rethrows the first exception thrown by a task since the last wait.
+    */
+    void wait();
+
+    /*
+     * numberOfWorkers - the number of worker threads.
+     *
+     * @return
+     * Returns the number of worker threads of the pool.
+    */
+    int numberOfWorkers() const;
+
+    /*
+     * defaultNumberOfWorkers - the hardware concurrency, or 1 if it is unknown.
+    */
+    static int defaultNumberOfWorkers();
+
+    /* The default number of elements handled by a single task of the parallel algorithms */
+    static const int DEFAULT_CHUNK_SIZE = 1024;
+
+private:
+
+    typedef std::function<void()> Task;
+
+    struct Worker {
+        ChaseLevDeque<Task*> m_deque;
+        std::thread m_thread;
+    };
+
+    Worker* m_workers;
+    int m_numberOfWorkers;
+
+    std::mutex m_injectionMutex;
+    Queue<Task*> m_injectionQueue;
+
+    /* Tasks that were submitted and not taken yet, used to put idle workers to sleep */
+    std::atomic<int> m_queuedTasks;
+    /* Tasks that were submitted and did not finish yet */
+    std::atomic<int> m_unfinishedTasks;
+    std::atomic<int> m_sleepers;
+    std::atomic<bool> m_stop;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_allDone;
+
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+
+    /* Pool and worker index of the current thread, -1 for threads that are not workers */
+    static thread_local WorkStealingPool* t_currentPool;
+    static thread_local int t_currentWorker;
+
+    /*
+     * schedule - pushes a task to the current worker's deque, or to the injection queue.
+     * @exception
+     * std::bad_alloc exception might be thrown.
+    */
+    void schedule(Task* task);
+
+    /*
+     * findTask - takes a task from the own deque, the injection queue, or another worker.
+     *
+     * @param workerIndex - index of the calling worker, -1 for outside threads.
+     * @param task - receives the task.
+     * @return
+     * Returns true if a task was found.
+    */
+    bool findTask(int workerIndex, Task*& task);
+
+    /*
+     * runTask - runs and frees a task, recording its exception if it throws.
+    */
+    void runTask(Task* task);
+
+    /*
+     * workerLoop - the main loop of a worker thread.
+    */
+    void workerLoop(int workerIndex);
+};
+
+
+template <class Function>
+void WorkStealingPool::submit(const Function& function){
+    Task* task = new Task(function);
+    try{
+        schedule(task);
+    } catch(...){
+        delete task;
+        throw;
+    }
+}
+
+
+/* --------------------------------------- Parallel Functions of Interface ---------------------------------------*/
+
+
+/*
+ * parallelTransform - Transforms the queue on the pool, chunkSize elements per task.
+ *
+ * @param pool - The pool that runs the transform.
+ * @param queue - The queue which will have a transform.
+ * @param transform - The operation that will be used to transform the queue, called concurrently.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by transform.
+*/
+template <class T, class Transform>
+void parallelTransform(WorkStealingPool& pool, Queue<T>& queue, const Transform& transform,
+                       int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    typename Queue<T>::Iterator chunkBegin = queue.begin();
+    int remaining = queue.size();
+    try{
+        while(remaining > 0){
+            int count = remaining < chunkSize ? remaining : chunkSize;
+            pool.submit([chunkBegin, count, &transform]() mutable {
+                for(int i = 0 ; i < count ; i++, ++chunkBegin){
+                    transform(*chunkBegin);
+                }
+            });
+            for(int i = 0 ; i < count ; i++){
+                ++chunkBegin;
+            }
+            remaining -= count;
+        }
+    } catch(...){
+        /* Tasks already submitted still refer to transform */
+        try{
+            pool.wait();
+        } catch(...) {}
+        throw;
+    }
+    pool.wait();
+}
+
+/*
+ * parallelFilter - Filters the queue on the pool, keeping the order of the elements.
+ *
+ * @param pool - The pool that runs the filter.
+ * @param queue - The queue which will be filtered.
+ * @param condition - The condition used to filter the queue, called concurrently.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @return
+ * Returns filtered queue.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by condition.
+*/
+template <class T, class Condition>
+Queue<T> parallelFilter(WorkStealingPool& pool, const Queue<T>& queue, const Condition& condition,
+                        int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    int numberOfChunks = (queue.size() + chunkSize - 1) / chunkSize;
+    Queue<T>* partialResults = new Queue<T>[numberOfChunks > 0 ? numberOfChunks : 1];
+    Queue<T> resultQueue;
+    try{
+        typename Queue<T>::ConstIterator chunkBegin = queue.begin();
+        int remaining = queue.size();
+        for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+            int count = remaining < chunkSize ? remaining : chunkSize;
+            Queue<T>* partialResult = partialResults + chunk;
+            pool.submit([chunkBegin, count, partialResult, &condition]() mutable {
+                for(int i = 0 ; i < count ; i++, ++chunkBegin){
+                    if(condition(*chunkBegin)){
+                        partialResult->pushBack(*chunkBegin);
+                    }
+                }
+            });
+            for(int i = 0 ; i < count ; i++){
+                ++chunkBegin;
+            }
+            remaining -= count;
+        }
+        pool.wait();
+
+        for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+            for(const T& data : partialResults[chunk]){
+                resultQueue.pushBack(data);
+            }
+        }
+    } catch(...){
+        /* Tasks already submitted still refer to partialResults */
+        try{
+            pool.wait();
+        } catch(...) {}
+        delete[] partialResults;
+        throw;
+    }
+    delete[] partialResults;
+    return resultQueue;
+}
+
+/*
+ * parallelReduce - Reduces the queue on the pool. Every task reduces chunkSize elements starting from identity,
+ * and the partial results are combined in the order of the chunks.
+ *
+ * @param pool - The pool that runs the reduction.
+ * @param queue - The queue to reduce.
+ * @param identity - The value every chunk starts from, such that combine(identity, x) == x.
+ * @param operation - Called as operation(result, element) for the elements of a chunk, called concurrently.
+ * @param combine - Called as combine(result, partialResult) to join the results of consecutive chunks.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @return
+ * Returns the combined result, or identity if the queue is empty.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by operation or combine.
+*/
+template <class T, class Result, class Operation, class Combine>
+Result parallelReduce(WorkStealingPool& pool, const Queue<T>& queue, const Result& identity, const Operation& operation,
+                      const Combine& combine, int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    int numberOfChunks = (queue.size() + chunkSize - 1) / chunkSize;
+    Queue<Result> partialResults;
+    for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+        partialResults.pushBack(identity);
+    }
+    try{
+        for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+            int chunkBegin = chunk * chunkSize;
+            int chunkEnd = chunkBegin + chunkSize < queue.size() ? chunkBegin + chunkSize : queue.size();
+            /* The queue of partial results does not grow any more, so the address stays valid */
+            Result* partialResult = &partialResults[chunk];
+            pool.submit([&queue, &operation, chunkBegin, chunkEnd, partialResult]() {
+                Result result = *partialResult;
+                for(int i = chunkBegin ; i < chunkEnd ; i++){
+                    result = operation(result, queue[i]);
+                }
+                *partialResult = result;
+            });
+        }
+    } catch(...){
+        /* Tasks already submitted still refer to partialResults */
+        try{
+            pool.wait();
+        } catch(...) {}
+        throw;
+    }
+    pool.wait();
+
+    Result result = identity;
+    for(const Result& partialResult : partialResults){
+        result = combine(result, partialResult);
+    }
+    return result;
+}
+
+/*
+ * parallelCountIf - Counts the elements of the queue that satisfy the condition, on the pool.
+ *
+ * @param pool - The pool that runs the count.
+ * @param queue - The queue to count in.
+ * @param condition - The condition to check, called concurrently.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @return
+ * Returns the number of elements for which condition returned true.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by condition.
+*/
+template <class T, class Condition>
+int parallelCountIf(WorkStealingPool& pool, const Queue<T>& queue, const Condition& condition,
+                    int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    return parallelReduce(pool, queue, 0, [&condition](int count, const T& data) {
+        return count + (condition(data) ? 1 : 0);
+    }, [](int count, int partialCount) {
+        return count + partialCount;
+    }, chunkSize);
+}
+
+/*
+ * parallelExtremeElement - index of the first smallest, or largest if MAXIMUM, element, or -1 if the queue is empty.
+ * Every chunk finds its own first extreme, and a later chunk only wins if its extreme is strictly better.
+*/
+template <bool MAXIMUM, class T>
+int parallelExtremeElement(WorkStealingPool& pool, const Queue<T>& queue, int chunkSize){
+    int numberOfChunks = (queue.size() + chunkSize - 1) / chunkSize;
+    Queue<int> partialResults;
+    for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+        partialResults.pushBack(chunk * chunkSize);
+    }
+    try{
+        for(int chunk = 0 ; chunk < numberOfChunks ; chunk++){
+            int chunkBegin = chunk * chunkSize;
+            int chunkEnd = chunkBegin + chunkSize < queue.size() ? chunkBegin + chunkSize : queue.size();
+            int* partialResult = &partialResults[chunk];
+            pool.submit([&queue, chunkBegin, chunkEnd, partialResult]() {
+                const T* extreme = &queue[chunkBegin];
+                int extremeIndex = chunkBegin;
+                for(int i = chunkBegin + 1 ; i < chunkEnd ; i++){
+                    const T& data = queue[i];
+                    if(MAXIMUM ? *extreme < data : data < *extreme){
+                        extreme = &data;
+                        extremeIndex = i;
+                    }
+                }
+                *partialResult = extremeIndex;
+            });
+        }
+    } catch(...){
+        /* Tasks already submitted still refer to partialResults */
+        try{
+            pool.wait();
+        } catch(...) {}
+        throw;
+    }
+    pool.wait();
+
+    int extremeIndex = -1;
+    for(int index : partialResults){
+        if(extremeIndex < 0 || (MAXIMUM ? queue[extremeIndex] < queue[index] : queue[index] < queue[extremeIndex])){
+            extremeIndex = index;
+        }
+    }
+    return extremeIndex;
+}
+
+/*
+ * parallelMinElement - Finds the smallest element of the queue according to operator<, on the pool.
+ *
+ * @param pool - The pool that runs the search.
+ * @param queue - The queue to search.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @return
+ * Returns the index of the first smallest element, or -1 if the queue is empty.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by operator< of T.
+*/
+template <class T>
+int parallelMinElement(WorkStealingPool& pool, const Queue<T>& queue, int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    return parallelExtremeElement<false>(pool, queue, chunkSize);
+}
+
+/*
+ * parallelMaxElement - Finds the largest element of the queue according to operator<, on the pool.
+ *
+ * @param pool - The pool that runs the search.
+ * @param queue - The queue to search.
+ * @param chunkSize - The number of elements handled by a single task.
+ * @return
+ * Returns the index of the first largest element, or -1 if the queue is empty.
+ * @exception
+ * std::bad_alloc exception might be thrown, as well as any exception thrown by operator< of T.
+*/
+template <class T>
+int parallelMaxElement(WorkStealingPool& pool, const Queue<T>& queue, int chunkSize = WorkStealingPool::DEFAULT_CHUNK_SIZE){
+    return parallelExtremeElement<true>(pool, queue, chunkSize);
+}
+
+/* ----------------------------------- End of Parallel Functions of Interface -----------------------------------*/
+
+#endif //WORK_STEALING_POOL_H
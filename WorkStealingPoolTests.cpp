@@ -0,0 +1,124 @@
+#include <atomic>
+
+#include "ChaseLevDeque.h"
+#include "WorkStealingPool.h"
+
+#define AGREGATE_TEST_RESULT(res, cond) (res) = ((res) && (cond))
+
+static bool isEven(int n)
+{
+	return (n % 2) == 0;
+}
+
+static void multiplyByThree(int& n)
+{
+	n *= 3;
+}
+
+namespace WorkStealingPoolTests {
+
+bool testChaseLevDeque()
+{
+	bool testResult = true;
+
+	ChaseLevDeque<int> deque(2);
+	for (int i = 1; i <= 100; i++) {
+		deque.pushBack(i);
+	}
+	AGREGATE_TEST_RESULT(testResult, deque.size() == 100);
+
+	int value = 0;
+	AGREGATE_TEST_RESULT(testResult, deque.popBack(value) && value == 100);
+	AGREGATE_TEST_RESULT(testResult, deque.stealFront(value) && value == 1);
+
+	int count = 0;
+	while (deque.popBack(value)) {
+		count++;
+	}
+	AGREGATE_TEST_RESULT(testResult, count == 98);
+	AGREGATE_TEST_RESULT(testResult, !deque.stealFront(value));
+
+	return testResult;
+}
+
+bool testSubmitAndWait()
+{
+	bool testResult = true;
+
+	WorkStealingPool pool(4);
+	std::atomic<int> counter(0);
+	for (int i = 0; i < 1000; i++) {
+		pool.submit([&counter, &pool]() {
+			counter++;
+			pool.submit([&counter]() { counter++; });
+		});
+	}
+	pool.wait();
+	AGREGATE_TEST_RESULT(testResult, counter.load() == 2000);
+
+	bool exceptionThrown = false;
+	pool.submit([]() { throw Queue<int>::EmptyQueue(); });
+	try {
+		pool.wait();
+	}
+	catch (Queue<int>::EmptyQueue& e) {
+		exceptionThrown = true;
+	}
+	AGREGATE_TEST_RESULT(testResult, exceptionThrown);
+
+	return testResult;
+}
+
+bool testParallelFunctions()
+{
+	bool testResult = true;
+
+	WorkStealingPool pool(3);
+	Queue<int> queue1;
+	for (int i = 1; i <= 1000; i++) {
+		queue1.pushBack(i);
+	}
+
+	Queue<int> queue2 = parallelFilter(pool, queue1, isEven, 64);
+	AGREGATE_TEST_RESULT(testResult, queue2.size() == 500);
+	int expected = 2;
+	for (int data : queue2) {
+		AGREGATE_TEST_RESULT(testResult, data == expected);
+		expected += 2;
+	}
+
+	parallelTransform(pool, queue1, multiplyByThree, 100);
+	expected = 3;
+	for (int data : queue1) {
+		AGREGATE_TEST_RESULT(testResult, data == expected);
+		expected += 3;
+	}
+
+	return testResult;
+}
+
+bool testParallelReductions()
+{
+	bool testResult = true;
+
+	WorkStealingPool pool(3);
+	Queue<int> queue3;
+	AGREGATE_TEST_RESULT(testResult, parallelMinElement(pool, queue3) == -1 && parallelCountIf(pool, queue3, isEven) == 0);
+	for (int i = 0; i < 1000; i++) {
+		queue3.pushBack((i * 37) % 101);
+	}
+
+	long long total = parallelReduce(pool, queue3, 0LL, [](long long result, int data) { return result + data; },
+		[](long long result, long long partialResult) { return result + partialResult; }, 64);
+	AGREGATE_TEST_RESULT(testResult, total == reduce(queue3, 0LL, [](long long result, int data) { return result + data; }));
+	AGREGATE_TEST_RESULT(testResult, parallelCountIf(pool, queue3, isEven, 64) == countIf(queue3, isEven));
+
+	/* every value repeats every 101 elements, so the first occurrence must win across chunks */
+	AGREGATE_TEST_RESULT(testResult, parallelMinElement(pool, queue3, 64) == minElement(queue3));
+	AGREGATE_TEST_RESULT(testResult, parallelMaxElement(pool, queue3, 64) == maxElement(queue3));
+	AGREGATE_TEST_RESULT(testResult, queue3[parallelMaxElement(pool, queue3, 7)] == 100);
+
+	return testResult;
+}
+
+}
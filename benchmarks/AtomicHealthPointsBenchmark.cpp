@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "BenchmarkUtils.h"
+#include "../AtomicHealthPoints.h"
+
+/*
+ * Contention benchmark: every thread damages and heals the same entity, for 1 to maxThreads threads.
+ * Compares a mutex-guarded HealthPoints with AtomicHealthPoints.
+ * Build with HealthPoints.cpp and AtomicHealthPoints.cpp.
+ *
+ * Usage: AtomicHealthPointsBenchmark [operationsPerThread] [maxThreads]
+*/
+
+namespace {
+
+class LockedHealthPoints {
+public:
+	LockedHealthPoints(int maxHP) : m_healthPoints(maxHP) {}
+
+	void damage(int hpToDecrease)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_healthPoints -= hpToDecrease;
+	}
+
+	void heal(int hpToAdd)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_healthPoints += hpToAdd;
+	}
+
+private:
+	std::mutex m_mutex;
+	HealthPoints m_healthPoints;
+};
+
+class LockFreeHealthPoints {
+public:
+	LockFreeHealthPoints(int maxHP) : m_healthPoints(maxHP) {}
+
+	void damage(int hpToDecrease)
+	{
+		m_healthPoints -= hpToDecrease;
+	}
+
+	void heal(int hpToAdd)
+	{
+		m_healthPoints += hpToAdd;
+	}
+
+private:
+	AtomicHealthPoints m_healthPoints;
+};
+
+template <class Entity>
+void runThreads(Entity& entity, int numberOfThreads, int operationsPerThread)
+{
+	std::thread* threads = new std::thread[numberOfThreads];
+	for (int t = 0; t < numberOfThreads; t++) {
+		threads[t] = std::thread([&entity, operationsPerThread]() {
+			for (int i = 0; i < operationsPerThread; i += 2) {
+				entity.damage(3);
+				entity.heal(3);
+			}
+		});
+	}
+	for (int t = 0; t < numberOfThreads; t++) {
+		threads[t].join();
+	}
+	delete[] threads;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int operationsPerThread = argc > 1 ? std::atoi(argv[1]) : 2000000;
+	int maxThreads = argc > 2 ? std::atoi(argv[2]) : 16;
+	std::cout << "sizeof: mutex-guarded " << sizeof(LockedHealthPoints) << " bytes, atomic "
+		<< sizeof(AtomicHealthPoints) << " bytes" << std::endl;
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		long long operations = static_cast<long long>(threads) * operationsPerThread;
+		std::cout << "--- " << threads << " threads ---" << std::endl;
+		{
+			LockedHealthPoints entity(1000);
+			runBenchmark([&]() { runThreads(entity, threads, operationsPerThread); }, "mutex HealthPoints", operations);
+		}
+		{
+			LockFreeHealthPoints entity(1000);
+			runBenchmark([&]() { runThreads(entity, threads, operationsPerThread); }, "AtomicHealthPoints", operations);
+		}
+	}
+	return 0;
+}
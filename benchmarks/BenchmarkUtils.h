@@ -0,0 +1,42 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+/*
+ * Benchmarks are standalone programs, built one at a time from the repository root, e.g.:
+ * g++ -std=c++20 -O2 -DNDEBUG -pthread -I. benchmarks/WorkStealingPoolBenchmark.cpp WorkStealingPool.cpp
+*/
+
+/*
+ * measureSeconds - runs the function once and returns the wall time it took.
+*/
+inline double measureSeconds(const std::function<void()>& function)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	function();
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+/*
+ * runBenchmark - runs the function once and reports the throughput of the given number of operations.
+ *
+ * @return
+ * Returns the measured operations per second.
+*/
+inline double runBenchmark(const std::function<void()>& benchmarkFunction, const std::string& benchmarkName,
+	long long numberOfOperations)
+{
+	double seconds = measureSeconds(benchmarkFunction);
+	double operationsPerSecond = seconds > 0 ? numberOfOperations / seconds : 0;
+	std::cout << benchmarkName << ": " << seconds * 1000 << " ms, "
+		<< operationsPerSecond / 1e6 << " Mops/s, "
+		<< (numberOfOperations > 0 ? seconds * 1e9 / numberOfOperations : 0) << " ns/op" << std::endl;
+	return operationsPerSecond;
+}
+
+#endif //BENCHMARK_UTILS_H
@@ -0,0 +1,51 @@
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+
+/*
+ * filter() on small queues, with the per thread QueueBufferCache enabled and disabled.
+ * Every call builds a result queue that is destroyed right after, which is where the cache helps.
+ *
+ * Usage: BufferCacheBenchmark [numberOfCalls] [elementsPerQueue]
+*/
+
+namespace {
+
+bool isOdd(int value)
+{
+	return (value & 1) != 0;
+}
+
+void benchmarkFilter(const char* name, const Queue<int>& queue, int numberOfCalls)
+{
+	QueueBufferCache::resetStatistics();
+	int selected = 0;
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfCalls; i++) {
+			selected += filter(queue, isOdd).size();
+		}
+	}, name, numberOfCalls);
+	QueueBufferCache::Statistics statistics = QueueBufferCache::statistics();
+	std::cout << "  " << selected / numberOfCalls << " selected per call, " << statistics.m_hits << " hits, "
+		<< statistics.m_misses << " misses" << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfCalls = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int elementsPerQueue = argc > 2 ? std::atoi(argv[2]) : 64;
+	Queue<int> queue;
+	for (int i = 0; i < elementsPerQueue; i++) {
+		queue.pushBack(i);
+	}
+
+	int defaultMaxBlocks = QueueBufferCache::maxBlocksPerClass();
+	QueueBufferCache::setMaxBlocksPerClass(0);
+	benchmarkFilter("filter, cache disabled", queue, numberOfCalls);
+	QueueBufferCache::setMaxBlocksPerClass(defaultMaxBlocks);
+	benchmarkFilter("filter, cache enabled", queue, numberOfCalls);
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include <cstdlib>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "BenchmarkUtils.h"
+#include "../CompressedQueue.h"
+
+/*
+ * Fills a Queue<int> and a CompressedQueue<int> with increasing IDs and with small values, then reads
+ * every element with forEach / a range for loop, and empties them with popFront.
+ * Memory is measured with glibc's mallinfo2, and is not reported on other C libraries. The QueueBufferCache
+ * is disabled, so arrays freed by one run are not reused, and missed, by the next.
+ *
+ * Usage: CompressedQueueBenchmark [numberOfElements]
+*/
+
+namespace {
+
+long long allocatedBytes()
+{
+#ifdef __GLIBC__
+	struct mallinfo2 info = mallinfo2();
+	return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+	return 0;
+#endif
+}
+
+int increasingId(int i)
+{
+	return 1000000 + 2 * i + (i % 3);
+}
+
+int smallValue(int i)
+{
+	return (i * 7919) % 61;
+}
+
+template <class Q, class Scan>
+void benchmarkQueue(const std::string& name, int numberOfElements, int (*value)(int), const Scan& scan)
+{
+	long long bytesBefore = allocatedBytes();
+	Q* queue = new Q();
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfElements; i++) {
+			queue->pushBack(value(i));
+		}
+	}, name + ", pushBack", numberOfElements);
+	long long bytes = allocatedBytes() - bytesBefore;
+	std::cout << "  " << static_cast<double>(bytes) / numberOfElements << " bytes per element" << std::endl;
+
+	long long checksum = 0;
+	runBenchmark([&]() {
+		checksum += scan(*queue);
+	}, name + ", scan", numberOfElements);
+	runBenchmark([&]() {
+		while (queue->size() > 0) {
+			checksum += queue->front();
+			queue->popFront();
+		}
+	}, name + ", popFront", numberOfElements);
+	std::cout << "  checksum " << checksum << std::endl;
+	delete queue;
+}
+
+long long scanQueue(const Queue<int>& queue)
+{
+	long long total = 0;
+	for (int data : queue) {
+		total += data;
+	}
+	return total;
+}
+
+long long scanCompressedQueue(const CompressedQueue<int>& queue)
+{
+	long long total = 0;
+	queue.forEach([&total](int data) {
+		total += data;
+	});
+	return total;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfElements = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+	QueueBufferCache::setMaxBlocksPerClass(0);
+
+	benchmarkQueue<Queue<int>>("Queue, increasing IDs", numberOfElements, increasingId, scanQueue);
+	benchmarkQueue<CompressedQueue<int>>("CompressedQueue, increasing IDs", numberOfElements, increasingId,
+		scanCompressedQueue);
+	benchmarkQueue<Queue<int>>("Queue, small values", numberOfElements, smallValue, scanQueue);
+	benchmarkQueue<CompressedQueue<int>>("CompressedQueue, small values", numberOfElements, smallValue,
+		scanCompressedQueue);
+
+	CompressedQueue<int> queue;
+	for (int i = 0; i < numberOfElements; i++) {
+		queue.pushBack(increasingId(i));
+	}
+	std::cout << "compression ratio of increasing IDs: " << queue.compressionRatio() << std::endl;
+	return 0;
+}
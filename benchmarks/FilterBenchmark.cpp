@@ -0,0 +1,86 @@
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+
+/*
+ * filter throughput per element size. "iterator loop" is the way filter used to walk the queue,
+ * through the checked ConstIterator one element at a time. "filter" is the current implementation,
+ * which scans the array directly and prefetches QUEUE_PREFETCH_DISTANCE elements ahead.
+ * Rebuild with -DQUEUE_PREFETCH_DISTANCE=<n> to tune the distance (0 disables prefetching).
+ *
+ * Usage: FilterBenchmark [bytesPerQueue]
+*/
+
+namespace {
+
+template <int SIZE>
+struct Record {
+	int m_key;
+	char m_payload[SIZE - sizeof(int)];
+};
+
+template <>
+struct Record<sizeof(int)> {
+	int m_key;
+};
+
+template <int SIZE>
+bool isSelected(const Record<SIZE>& record)
+{
+	return (record.m_key & 7) == 0;
+}
+
+template <int SIZE>
+Queue<Record<SIZE>> iteratorLoopFilter(const Queue<Record<SIZE>>& queue)
+{
+	Queue<Record<SIZE>> resultQueue;
+	for (const Record<SIZE>& data : queue) {
+		if (isSelected(data)) {
+			resultQueue.pushBack(data);
+		}
+	}
+	return resultQueue;
+}
+
+template <int SIZE>
+void benchmarkSize(long long bytesPerQueue)
+{
+	int numberOfElements = static_cast<int>(bytesPerQueue / SIZE);
+	Queue<Record<SIZE>> queue;
+	Record<SIZE> record = Record<SIZE>();
+	for (int i = 0; i < numberOfElements; i++) {
+		record.m_key = (i * 2654435761u) >> 7;
+		queue.pushBack(record);
+	}
+
+	const int REPETITIONS = 5;
+	int selected = 0;
+	std::cout << "--- " << SIZE << " byte elements, " << numberOfElements << " elements ---" << std::endl;
+	runBenchmark([&]() {
+		for (int i = 0; i < REPETITIONS; i++) {
+			selected += iteratorLoopFilter(queue).size();
+		}
+	}, "iterator loop", static_cast<long long>(numberOfElements) * REPETITIONS);
+	runBenchmark([&]() {
+		for (int i = 0; i < REPETITIONS; i++) {
+			selected -= filter(queue, isSelected<SIZE>).size();
+		}
+	}, "filter", static_cast<long long>(numberOfElements) * REPETITIONS);
+	if (selected != 0) {
+		std::cout << "results differ" << std::endl;
+	}
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	long long bytesPerQueue = argc > 1 ? std::atoll(argv[1]) : 256LL * 1024 * 1024;
+	std::cout << "prefetch distance " << Queue<int>::PREFETCH_DISTANCE << std::endl;
+	benchmarkSize<4>(bytesPerQueue);
+	benchmarkSize<64>(bytesPerQueue);
+	benchmarkSize<128>(bytesPerQueue);
+	benchmarkSize<256>(bytesPerQueue);
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "../HealthPointsLoader.h"
+
+/*
+ * Writes a dump of HealthPoints records, one per line, and loads it back with HealthPointsLoader::loadFile
+ * (memory mapped), with HealthPointsLoader::loadStream from an ifstream (chunked reads, as from a pipe),
+ * and with a hand written operator>> loop. The file is read once before the runs, so it is in the page cache.
+ * Build with HealthPoints.cpp and HealthPointsLoader.cpp.
+ *
+ * Usage: HealthPointsLoaderBenchmark [numberOfRecords] [path]
+*/
+
+namespace {
+
+long long writeDump(const std::string& path, long long numberOfRecords)
+{
+	std::ofstream file(path, std::ios::binary);
+	unsigned state = 1;
+	for (long long i = 0; i < numberOfRecords; i++) {
+		state = state * 1103515245u + 12345u;
+		int maxHP = 1 + static_cast<int>((state >> 8) % 100000);
+		int currentHP = static_cast<int>((state >> 4) % (static_cast<unsigned>(maxHP) + 1));
+		file << currentHP << '(' << maxHP << ")\n";
+	}
+	return static_cast<long long>(file.tellp());
+}
+
+void report(const std::string& name, double seconds, long long bytes, long long records)
+{
+	std::cout << name << ": " << seconds * 1000 << " ms, " << bytes / seconds / 1e9 << " GB/s, "
+		<< records / seconds / 1e6 << " Mrecords/s" << std::endl;
+}
+
+/* The hand written loader the streaming one replaces */
+long long loadWithOperators(std::istream& stream, Queue<HealthPoints>& destination)
+{
+	long long records = 0;
+	int currentHP = 0;
+	int maxHP = 0;
+	char open = 0;
+	char close = 0;
+	while (stream >> currentHP >> open >> maxHP >> close) {
+		HealthPoints healthPoints(maxHP);
+		healthPoints -= maxHP - currentHP;
+		destination.pushBack(healthPoints);
+		records++;
+	}
+	return records;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	long long numberOfRecords = argc > 1 ? std::atoll(argv[1]) : 1 << 25;
+	std::string path = argc > 2 ? argv[2] : "HealthPointsLoaderBenchmark.tmp";
+
+	long long bytes = writeDump(path, numberOfRecords);
+	std::cout << numberOfRecords << " records, " << bytes / 1e9 << " GB" << std::endl;
+	{
+		Queue<HealthPoints> warmUp;
+		HealthPointsLoader::loadFile(path, warmUp);
+	}
+
+	long long records = 0;
+	{
+		Queue<HealthPoints> queue;
+		double seconds = measureSeconds([&]() { records = HealthPointsLoader::loadFile(path, queue); });
+		report("loadFile, mapped", seconds, bytes, records);
+	}
+	{
+		Queue<HealthPoints> queue;
+		std::ifstream stream(path, std::ios::binary);
+		double seconds = measureSeconds([&]() { records = HealthPointsLoader::loadStream(stream, queue); });
+		report("loadStream, chunked reads", seconds, bytes, records);
+	}
+	{
+		Queue<HealthPoints> queue;
+		std::ifstream stream(path, std::ios::binary);
+		double seconds = measureSeconds([&]() { records = loadWithOperators(stream, queue); });
+		report("operator>> loop", seconds, bytes, records);
+	}
+
+	std::remove(path.c_str());
+	return 0;
+}
@@ -0,0 +1,426 @@
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../HealthPoints.h"
+#include "../Queue.h"
+#include "../TestUtils.h"
+
+/*
+ * Differential check of Queue<T> against std::deque and a std::vector-backed ring. Each run generates a random
+ * stream of pushBack, popFront, front, iterate, filter and transform operations from a seed, and the same stream
+ * drives the three containers:
+ * - The values every container observes (fronts, popped elements, sums of iterations, the results of filter and
+ *   the final elements) must be the same, else the run reports the first operation where they differ.
+ * - Each container is timed on the stream, best of a few repeats, and its heap allocations are counted (operator
+ *   new, and QueueBufferCache misses for Queue).
+ * - Queue must reach at least 1 / maxSlowdown of the ops/sec of each baseline.
+ * Every workload and element type is reported with runTest as in TestMain, and the exit code is the number
+ * of failed runs.
+ *
+ * Usage: QueueDifferentialHarness [numberOfOperations] [maxSlowdown] [seed]
+ * Build with HealthPoints.cpp.
+*/
+
+namespace {
+
+long long g_allocations = 0;
+
+/* The operations of a stream, ITERATE sums the elements, FILTER keeps some in a new container */
+enum OperationKind { PUSH, POP, FRONT, ITERATE, FILTER, TRANSFORM };
+
+struct Operation {
+	OperationKind m_kind;
+	unsigned int m_value;
+};
+
+/*
+ * Workload - the relative weights of the operations, and the size above which pushes become pops.
+*/
+struct Workload {
+	const char* m_name;
+	int m_weights[TRANSFORM + 1];
+	int m_maxSize;
+};
+
+std::vector<Operation> makeOperations(const Workload& workload, int numberOfOperations, unsigned int seed)
+{
+	int totalWeight = 0;
+	for (int weight : workload.m_weights) {
+		totalWeight += weight;
+	}
+	std::vector<Operation> operations;
+	operations.reserve(numberOfOperations);
+	unsigned int random = seed;
+	int size = 0;
+	for (int i = 0; i < numberOfOperations; i++) {
+		random = random * 1103515245 + 12345;
+		int pick = static_cast<int>((random >> 8) % totalWeight);
+		int kind = 0;
+		while (pick >= workload.m_weights[kind]) {
+			pick -= workload.m_weights[kind];
+			kind++;
+		}
+		if (kind == PUSH && size >= workload.m_maxSize) {
+			kind = POP;
+		}
+		size += kind == PUSH ? 1 : (kind == POP && size > 0 ? -1 : 0);
+		random = random * 1103515245 + 12345;
+		operations.push_back(Operation{ static_cast<OperationKind>(kind), random >> 4 });
+	}
+	return operations;
+}
+
+struct IntElements {
+	typedef int Type;
+	static const char* name() { return "int"; }
+	static int make(unsigned int value) { return static_cast<int>(value % 100000); }
+	static long long key(int data) { return data; }
+	static bool keep(int data) { return data % 3 != 0; }
+	static void change(int& data) { data = (data * 7 + 1) % 100000; }
+};
+
+struct HealthPointsElements {
+	typedef HealthPoints Type;
+	static const char* name() { return "HealthPoints"; }
+	static HealthPoints make(unsigned int value)
+	{
+		HealthPoints healthPoints(1000);
+		healthPoints -= static_cast<int>(value % 1000);
+		return healthPoints;
+	}
+	static long long key(const HealthPoints& data) { return radixKey(data); }
+	static bool keep(const HealthPoints& data) { return data < 500; }
+	static void change(HealthPoints& data) { data -= 1; }
+};
+
+template <class T>
+class QueueContainer {
+public:
+	static const char* name() { return "Queue"; }
+	void pushBack(const T& data) { m_queue.pushBack(data); }
+	void popFront() { m_queue.popFront(); }
+	const T& front() const { return m_queue.front(); }
+	int size() const { return m_queue.size(); }
+	template <class Function>
+	void forEach(const Function& function) const
+	{
+		for (const T& data : m_queue) {
+			function(data);
+		}
+	}
+	template <class Condition>
+	QueueContainer filter(const Condition& condition) const
+	{
+		QueueContainer result;
+		result.m_queue = ::filter(m_queue, condition);
+		return result;
+	}
+	template <class Transform>
+	void transform(const Transform& transform) { ::transform(m_queue, transform); }
+
+private:
+	Queue<T> m_queue;
+};
+
+template <class T>
+class DequeContainer {
+public:
+	static const char* name() { return "std::deque"; }
+	void pushBack(const T& data) { m_deque.push_back(data); }
+	void popFront() { m_deque.pop_front(); }
+	const T& front() const { return m_deque.front(); }
+	int size() const { return static_cast<int>(m_deque.size()); }
+	template <class Function>
+	void forEach(const Function& function) const
+	{
+		for (const T& data : m_deque) {
+			function(data);
+		}
+	}
+	template <class Condition>
+	DequeContainer filter(const Condition& condition) const
+	{
+		DequeContainer result;
+		for (const T& data : m_deque) {
+			if (condition(data)) {
+				result.m_deque.push_back(data);
+			}
+		}
+		return result;
+	}
+	template <class Transform>
+	void transform(const Transform& transform)
+	{
+		for (T& data : m_deque) {
+			transform(data);
+		}
+	}
+
+private:
+	std::deque<T> m_deque;
+};
+
+/* A ring over a std::vector whose size is a power of two, doubled when full */
+template <class T>
+class RingContainer {
+public:
+	static const char* name() { return "std::vector ring"; }
+	RingContainer() : m_data(INITIAL_SIZE), m_first(0), m_size(0) {}
+	void pushBack(const T& data)
+	{
+		if (m_size == static_cast<int>(m_data.size())) {
+			std::vector<T> larger(m_data.size() * 2);
+			for (int i = 0; i < m_size; i++) {
+				larger[i] = m_data[place(i)];
+			}
+			m_data.swap(larger);
+			m_first = 0;
+		}
+		m_data[place(m_size)] = data;
+		m_size++;
+	}
+	void popFront()
+	{
+		m_first = place(1);
+		m_size--;
+	}
+	const T& front() const { return m_data[m_first]; }
+	int size() const { return m_size; }
+	template <class Function>
+	void forEach(const Function& function) const
+	{
+		for (int i = 0; i < m_size; i++) {
+			function(m_data[place(i)]);
+		}
+	}
+	template <class Condition>
+	RingContainer filter(const Condition& condition) const
+	{
+		RingContainer result;
+		forEach([&result, &condition](const T& data) {
+			if (condition(data)) {
+				result.pushBack(data);
+			}
+		});
+		return result;
+	}
+	template <class Transform>
+	void transform(const Transform& transform)
+	{
+		for (int i = 0; i < m_size; i++) {
+			transform(m_data[place(i)]);
+		}
+	}
+
+private:
+	static const int INITIAL_SIZE = 16;
+	std::vector<T> m_data;
+	int m_first;
+	int m_size;
+
+	int place(int index) const { return (m_first + index) & (static_cast<int>(m_data.size()) - 1); }
+};
+
+/*
+ * runOperations - drives a container with a stream, and returns a checksum of what it observes.
+ * If log is not nullptr every observed value is also added to it, with the index of its operation.
+*/
+template <class Elements, class Container>
+unsigned long long runOperations(Container& container, const std::vector<Operation>& operations,
+	std::vector<std::pair<int, long long>>* log)
+{
+	typedef typename Elements::Type T;
+	unsigned long long checksum = 0;
+	int index = 0;
+	auto observe = [&checksum, &index, log](long long value) {
+		checksum = checksum * 1000003 + static_cast<unsigned long long>(value);
+		if (log != nullptr) {
+			log->push_back(std::pair<int, long long>(index, value));
+		}
+	};
+	for (; index < static_cast<int>(operations.size()); index++) {
+		const Operation& operation = operations[index];
+		switch (operation.m_kind) {
+		case PUSH:
+			container.pushBack(Elements::make(operation.m_value));
+			break;
+		case POP:
+			if (container.size() > 0) {
+				observe(Elements::key(container.front()));
+				container.popFront();
+			}
+			break;
+		case FRONT:
+			observe(container.size() > 0 ? Elements::key(container.front()) : -1);
+			break;
+		case ITERATE: {
+			long long total = 0;
+			container.forEach([&total](const T& data) { total += Elements::key(data); });
+			observe(total);
+			break;
+		}
+		case FILTER: {
+			Container kept = container.filter([](const T& data) { return Elements::keep(data); });
+			observe(kept.size());
+			observe(kept.size() > 0 ? Elements::key(kept.front()) : -1);
+			break;
+		}
+		case TRANSFORM:
+			container.transform([](T& data) { Elements::change(data); });
+			break;
+		}
+	}
+	observe(container.size());
+	container.forEach([&observe](const T& data) { observe(Elements::key(data)); });
+	return checksum;
+}
+
+/*
+ * Measurement - what a container observed on a stream, and how fast.
+*/
+struct Measurement {
+	std::vector<std::pair<int, long long>> m_log;
+	double m_operationsPerSecond = 0;
+	long long m_allocations = 0;
+};
+
+template <class Elements, class Container>
+Measurement measure(const std::vector<Operation>& operations, int repeats)
+{
+	Measurement measurement;
+	{
+		Container container;
+		runOperations<Elements>(container, operations, &measurement.m_log);
+	}
+
+	/* Counted on a run of its own, without the log, and with no arrays cached by the runs before it */
+	QueueBufferCache::trim();
+	QueueBufferCache::resetStatistics();
+	long long allocationsBefore = g_allocations;
+	{
+		Container container;
+		runOperations<Elements>(container, operations, nullptr);
+	}
+	measurement.m_allocations = g_allocations - allocationsBefore + QueueBufferCache::statistics().m_misses;
+
+	double bestSeconds = 0;
+	unsigned long long checksum = 0;
+	for (int repeat = 0; repeat < repeats; repeat++) {
+		double seconds = measureSeconds([&checksum, &operations]() {
+			Container container;
+			checksum += runOperations<Elements>(container, operations, nullptr);
+		});
+		bestSeconds = repeat == 0 || seconds < bestSeconds ? seconds : bestSeconds;
+	}
+	measurement.m_operationsPerSecond = bestSeconds > 0 ? operations.size() / bestSeconds : 0;
+	std::cout << "  " << Container::name() << ": " << measurement.m_operationsPerSecond / 1e6 << " Mops/s, "
+		<< measurement.m_allocations << " allocations (checksum " << checksum % 1000 << ")" << std::endl;
+	return measurement;
+}
+
+/*
+ * sameObservations - checks that a baseline observed what Queue observed, and reports the first difference.
+*/
+bool sameObservations(const Measurement& queue, const Measurement& baseline, const char* baselineName,
+	const std::vector<Operation>& operations)
+{
+	static const char* const KIND_NAMES[] = { "pushBack", "popFront", "front", "iterate", "filter", "transform" };
+	std::size_t count = queue.m_log.size() < baseline.m_log.size() ? queue.m_log.size() : baseline.m_log.size();
+	for (std::size_t i = 0; i <= count; i++) {
+		if (i == count && queue.m_log.size() == baseline.m_log.size()) {
+			return true;
+		}
+		if (i == count || queue.m_log[i] != baseline.m_log[i]) {
+			int index = i < count ? queue.m_log[i].first : -1;
+			std::cout << "  Queue and " << baselineName << " differ at observation " << i;
+			if (index >= 0 && index < static_cast<int>(operations.size())) {
+				std::cout << ", operation " << index << " (" << KIND_NAMES[operations[index].m_kind] << "): "
+					<< queue.m_log[i].second << " against " << baseline.m_log[i].second;
+			}
+			std::cout << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool fastEnough(const Measurement& queue, const Measurement& baseline, const char* baselineName, double maxSlowdown)
+{
+	if (queue.m_operationsPerSecond * maxSlowdown >= baseline.m_operationsPerSecond) {
+		return true;
+	}
+	std::cout << "  Queue is " << baseline.m_operationsPerSecond / queue.m_operationsPerSecond << " times slower than "
+		<< baselineName << ", more than the allowed " << maxSlowdown << std::endl;
+	return false;
+}
+
+template <class Elements>
+bool runDifferential(const Workload& workload, int numberOfOperations, double maxSlowdown, unsigned int seed)
+{
+	const int REPEATS = 5;
+	typedef typename Elements::Type T;
+	std::cout << Elements::name() << ", " << workload.m_name << " workload, seed " << seed << std::endl;
+	std::vector<Operation> operations = makeOperations(workload, numberOfOperations, seed);
+	Measurement queue = measure<Elements, QueueContainer<T>>(operations, REPEATS);
+	Measurement deque = measure<Elements, DequeContainer<T>>(operations, REPEATS);
+	Measurement ring = measure<Elements, RingContainer<T>>(operations, REPEATS);
+
+	bool result = sameObservations(queue, deque, DequeContainer<T>::name(), operations);
+	result = sameObservations(queue, ring, RingContainer<T>::name(), operations) && result;
+	result = fastEnough(queue, deque, DequeContainer<T>::name(), maxSlowdown) && result;
+	result = fastEnough(queue, ring, RingContainer<T>::name(), maxSlowdown) && result;
+	return result;
+}
+
+}
+
+void* operator new(std::size_t bytes)
+{
+	g_allocations++;
+	void* block = std::malloc(bytes > 0 ? bytes : 1);
+	if (block == nullptr) {
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void operator delete(void* block) noexcept
+{
+	std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+	std::free(block);
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfOperations = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+	double maxSlowdown = argc > 2 ? std::atof(argv[2]) : 1.5;
+	unsigned int seed = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 2024;
+
+	/* Weights of pushBack, popFront, front, iterate, filter and transform */
+	const Workload FIFO = { "fifo", { 50, 40, 10, 0, 0, 0 }, 1 << 16 };
+	const Workload MIXED = { "mixed", { 40, 30, 15, 5, 5, 5 }, 1 << 10 };
+
+	int failures = 0;
+	auto check = [&failures](bool result) {
+		failures += result ? 0 : 1;
+		return result;
+	};
+	runTest([&]() { return check(runDifferential<IntElements>(FIFO, numberOfOperations, maxSlowdown, seed)); },
+		"Differential int fifo");
+	runTest([&]() { return check(runDifferential<IntElements>(MIXED, numberOfOperations / 8, maxSlowdown, seed)); },
+		"Differential int mixed");
+	runTest([&]() { return check(runDifferential<HealthPointsElements>(FIFO, numberOfOperations, maxSlowdown, seed)); },
+		"Differential HealthPoints fifo");
+	runTest([&]() {
+		return check(runDifferential<HealthPointsElements>(MIXED, numberOfOperations / 8, maxSlowdown, seed));
+	}, "Differential HealthPoints mixed");
+	return failures;
+}
@@ -0,0 +1,89 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+#include "../QueueTrace.h"
+
+/*
+ * Overhead of tracing: a pushBack and popFront loop, then QueueTrace::record alone at a few sample rates,
+ * flushing the events as they are recorded. In the loop the buffer fills and the events beyond it are dropped. Build once as is and once with -DQUEUE_TRACE_ENABLED=1 to compare
+ * the loop without and with the hooks. If a path is given the last trace is written to it, for a trace viewer.
+ *
+ * Usage: QueueTraceBenchmark [numberOfOperations] [tracePath]
+*/
+
+namespace {
+
+void benchmarkPushPop(int numberOfOperations, int sampleRate)
+{
+	Queue<int> queue;
+	long long total = 0;
+	QueueTrace::setSampleRate(sampleRate);
+	std::string name = std::string(QUEUE_TRACE_ENABLED ? "pushBack and popFront, hooks compiled in" :
+		"pushBack and popFront, hooks compiled out") + ", sample rate " + std::to_string(sampleRate);
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfOperations; i++) {
+			queue.pushBack(i);
+			if (i % 4 != 0) {
+				total += queue.front();
+				queue.popFront();
+			}
+		}
+	}, name, numberOfOperations);
+	QueueTrace::setSampleRate(1);
+	std::ostringstream discarded;
+	long long events = QueueTrace::flush(discarded);
+	std::cout << "  " << queue.size() << " elements left, total " << total << ", " << events << " events" << std::endl;
+}
+
+void benchmarkRecord(int numberOfOperations, int sampleRate, std::ostream& traceStream)
+{
+	/* Flushed often enough that the buffer never fills, as a profiling run would */
+	const int OPERATIONS_PER_FLUSH = 1 << 14;
+	int object = 0;
+	long long events = 0;
+	QueueTrace::setSampleRate(sampleRate);
+	std::string name = "record and flush, sample rate " + std::to_string(sampleRate);
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfOperations; i++) {
+			QueueTrace::record(QueueTrace::PUSH, &object, i);
+			if (i % OPERATIONS_PER_FLUSH == OPERATIONS_PER_FLUSH - 1) {
+				events += QueueTrace::flush(traceStream);
+			}
+		}
+	}, name, numberOfOperations);
+	QueueTrace::setSampleRate(1);
+	events += QueueTrace::flush(traceStream);
+	std::cout << "  " << events << " events written, " << QueueTrace::droppedEvents() << " dropped" << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfOperations = argc > 1 ? std::atoi(argv[1]) : 1 << 24;
+
+	benchmarkPushPop(numberOfOperations, 1);
+	benchmarkPushPop(numberOfOperations, 256);
+	for (int sampleRate : { 1, 16, 256 }) {
+		std::ostringstream trace;
+		benchmarkRecord(numberOfOperations, sampleRate, trace);
+	}
+
+	if (argc > 2) {
+		/* A single flush, so the file is one trace */
+		std::ofstream traceFile(argv[2]);
+		int object = 0;
+		for (int i = 0; i < QUEUE_TRACE_BUFFER_EVENTS; i++) {
+			QueueTrace::record(QueueTrace::PUSH, &object, i);
+		}
+		long long events = 0;
+		double seconds = measureSeconds([&]() {
+			events = QueueTrace::flush(traceFile);
+		});
+		std::cout << "flush of " << events << " events to " << argv[2] << ": " << seconds * 1000 << " ms" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "../WorkStealingPool.h"
+
+/*
+ * Sum, count and minimum of a large Queue<int>, written as a loop over the iterators, with the vectorized
+ * reductions of Queue.h and with the chunked reductions of WorkStealingPool.h.
+ *
+ * Usage: ReductionBenchmark [numberOfElements] [numberOfRepeats] [numberOfThreads]
+*/
+
+namespace {
+
+bool isNegative(int value)
+{
+	return value < 0;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfElements = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+	int numberOfRepeats = argc > 2 ? std::atoi(argv[2]) : 50;
+	int numberOfThreads = argc > 3 ? std::atoi(argv[3]) : 4;
+	Queue<int> queue;
+	for (int i = 0; i < numberOfElements; i++) {
+		queue.pushBack((i * 7919) % 100003 - 50000);
+	}
+	long long operations = static_cast<long long>(numberOfElements) * numberOfRepeats;
+	long long checksum = 0;
+
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			int total = 0;
+			for (int data : queue) {
+				total += data;
+			}
+			checksum += total;
+		}
+	}, "sum, iterator loop", operations);
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			checksum += sum(queue);
+		}
+	}, "sum", operations);
+
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			int count = 0;
+			for (int data : queue) {
+				count += isNegative(data) ? 1 : 0;
+			}
+			checksum += count;
+		}
+	}, "count, iterator loop", operations);
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			checksum += countIf(queue, [](int value) { return value < 0; });
+		}
+	}, "countIf", operations);
+
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			int minimum = queue.front();
+			for (int data : queue) {
+				minimum = data < minimum ? data : minimum;
+			}
+			checksum += minimum;
+		}
+	}, "min, iterator loop", operations);
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			checksum += minElement(queue);
+		}
+	}, "minElement", operations);
+
+	WorkStealingPool pool(numberOfThreads);
+	int chunkSize = 1 << 16;
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			checksum += parallelCountIf(pool, queue, isNegative, chunkSize);
+		}
+	}, "parallelCountIf", operations);
+	runBenchmark([&]() {
+		for (int repeat = 0; repeat < numberOfRepeats; repeat++) {
+			checksum += parallelMinElement(pool, queue, chunkSize);
+		}
+	}, "parallelMinElement", operations);
+
+	std::cout << "checksum " << checksum << std::endl;
+	return 0;
+}
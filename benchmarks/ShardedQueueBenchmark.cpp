@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "BenchmarkUtils.h"
+#include "../ShardedQueue.h"
+
+/*
+ * High fan-in scaling benchmark: every thread pushes and pops in a loop, for 1 to maxThreads threads.
+ * Compares a single mutex-wrapped Queue<int> with ShardedQueue<int> in both ordering modes.
+ *
+ * Usage: ShardedQueueBenchmark [operationsPerThread] [maxThreads]
+*/
+
+namespace {
+
+class MutexQueue {
+public:
+	void pushBack(int value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_data.pushBack(value);
+	}
+
+	bool popFrontInto(int& value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_data.popFrontInto(value);
+	}
+
+private:
+	std::mutex m_mutex;
+	Queue<int> m_data;
+};
+
+/*
+ * Each thread pushes two elements for every pop, so the queue keeps growing like an ingest queue
+ * whose consumers lag behind.
+*/
+template <class QueueType>
+void runThreads(QueueType& queue, int numberOfThreads, int operationsPerThread)
+{
+	std::thread* threads = new std::thread[numberOfThreads];
+	for (int t = 0; t < numberOfThreads; t++) {
+		threads[t] = std::thread([&queue, operationsPerThread, t]() {
+			int value = 0;
+			for (int i = 0; i < operationsPerThread; i += 3) {
+				queue.pushBack(t);
+				queue.pushBack(i);
+				queue.popFrontInto(value);
+			}
+		});
+	}
+	for (int t = 0; t < numberOfThreads; t++) {
+		threads[t].join();
+	}
+	delete[] threads;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int operationsPerThread = argc > 1 ? std::atoi(argv[1]) : 300000;
+	int maxThreads = argc > 2 ? std::atoi(argv[2]) : 64;
+	std::cout << operationsPerThread << " operations per thread, "
+		<< std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		long long operations = static_cast<long long>(threads) * operationsPerThread;
+		std::cout << "--- " << threads << " threads ---" << std::endl;
+		{
+			MutexQueue queue;
+			runBenchmark([&]() { runThreads(queue, threads, operationsPerThread); }, "mutex Queue", operations);
+		}
+		{
+			ShardedQueue<int> queue(ShardedQueue<int>::defaultNumberOfShards(),
+				ShardedQueue<int>::Ordering::PER_PRODUCER_FIFO, ShardedQueue<int>::Selection::ROUND_ROBIN);
+			runBenchmark([&]() { runThreads(queue, threads, operationsPerThread); },
+				"sharded, per-producer FIFO, round robin", operations);
+		}
+		{
+			ShardedQueue<int> queue(ShardedQueue<int>::defaultNumberOfShards(),
+				ShardedQueue<int>::Ordering::RELAXED_FIFO, ShardedQueue<int>::Selection::POWER_OF_TWO_CHOICES);
+			runBenchmark([&]() { runThreads(queue, threads, operationsPerThread); },
+				"sharded, relaxed FIFO, two choices", operations);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,158 @@
+#include <cstdlib>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "BenchmarkUtils.h"
+#include "../SharedMemoryQueue.h"
+
+/*
+ * Passes 64 byte messages from a forked producer process to the parent, through a pipe (one write and
+ * one read per message) and through SharedMemoryQueue. Measures the throughput of a one way stream,
+ * and the round trip latency of a ping-pong over two channels.
+ * Linux only. Older glibc versions need -lrt for shm_open.
+ *
+ * Usage: SharedMemoryQueueBenchmark [numberOfMessages] [numberOfRoundTrips]
+*/
+
+namespace {
+
+struct Message {
+	long long m_sequence;
+	char m_payload[56];
+};
+
+class PipeChannel {
+public:
+	PipeChannel()
+	{
+		if (pipe(m_fileDescriptors) != 0) {
+			std::exit(1);
+		}
+	}
+
+	void send(const Message& message)
+	{
+		if (write(m_fileDescriptors[1], &message, sizeof(message)) != static_cast<ssize_t>(sizeof(message))) {
+			std::exit(1);
+		}
+	}
+
+	void receive(Message& message)
+	{
+		char* destination = reinterpret_cast<char*>(&message);
+		std::size_t received = 0;
+		while (received < sizeof(message)) {
+			ssize_t bytes = read(m_fileDescriptors[0], destination + received, sizeof(message) - received);
+			if (bytes <= 0) {
+				std::exit(1);
+			}
+			received += bytes;
+		}
+	}
+
+private:
+	int m_fileDescriptors[2];
+};
+
+/*
+ * The forked child uses the parent's instance, whose mapping it inherits. It leaves with _exit,
+ * so only the parent removes the segment.
+*/
+class SharedMemoryChannel {
+public:
+	explicit SharedMemoryChannel(const std::string& name) : m_queue(name, 1024) {}
+
+	void send(const Message& message)
+	{
+		m_queue.pushBack(message);
+	}
+
+	void receive(Message& message)
+	{
+		m_queue.waitPopFrontInto(message);
+	}
+
+private:
+	SharedMemoryQueue<Message> m_queue;
+};
+
+/*
+ * stream - the child sends numberOfMessages messages, the parent receives them.
+*/
+template <class Channel>
+void stream(Channel& channel, int numberOfMessages)
+{
+	pid_t child = fork();
+	if (child == 0) {
+		Message message = Message();
+		for (int i = 0; i < numberOfMessages; i++) {
+			message.m_sequence = i;
+			channel.send(message);
+		}
+		_exit(0);
+	}
+	Message message;
+	for (int i = 0; i < numberOfMessages; i++) {
+		channel.receive(message);
+	}
+	waitpid(child, nullptr, 0);
+}
+
+/*
+ * pingPong - the parent sends on request and waits for the child to answer on response.
+*/
+template <class Channel>
+void pingPong(Channel& request, Channel& response, int numberOfRoundTrips)
+{
+	pid_t child = fork();
+	if (child == 0) {
+		Message message;
+		for (int i = 0; i < numberOfRoundTrips; i++) {
+			request.receive(message);
+			response.send(message);
+		}
+		_exit(0);
+	}
+	Message message = Message();
+	for (int i = 0; i < numberOfRoundTrips; i++) {
+		message.m_sequence = i;
+		request.send(message);
+		response.receive(message);
+	}
+	waitpid(child, nullptr, 0);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfMessages = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int numberOfRoundTrips = argc > 2 ? std::atoi(argv[2]) : 50000;
+	std::string prefix = "/queue-benchmark-" + std::to_string(getpid());
+
+	std::cout << "--- stream of " << numberOfMessages << " messages ---" << std::endl;
+	{
+		PipeChannel channel;
+		runBenchmark([&]() { stream(channel, numberOfMessages); }, "pipe", numberOfMessages);
+	}
+	{
+		SharedMemoryChannel channel(prefix + "-stream");
+		runBenchmark([&]() { stream(channel, numberOfMessages); }, "SharedMemoryQueue", numberOfMessages);
+	}
+
+	std::cout << "--- ping-pong, " << numberOfRoundTrips << " round trips ---" << std::endl;
+	{
+		PipeChannel request;
+		PipeChannel response;
+		runBenchmark([&]() { pingPong(request, response, numberOfRoundTrips); }, "pipe", numberOfRoundTrips);
+	}
+	{
+		SharedMemoryChannel request(prefix + "-request");
+		SharedMemoryChannel response(prefix + "-response");
+		runBenchmark([&]() { pingPong(request, response, numberOfRoundTrips); }, "SharedMemoryQueue",
+			numberOfRoundTrips);
+	}
+	return 0;
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../HealthPoints.h"
+#include "../Queue.h"
+
+/*
+ * Sorting a queue that wraps around the end of its array: copied out to a std::vector, sorted and pushed back
+ * to a new queue, then sorted in place by comparison and by radix. Done for random ints and for HealthPoints,
+ * whose radix key is the current hp. Last, sorted queues are merged, compared with splicing them and sorting.
+ *
+ * Usage: SortBenchmark [numberOfElements] [numberOfQueuesToMerge]
+ * Build with HealthPoints.cpp.
+*/
+
+namespace {
+
+template <class T>
+Queue<T> wrappedQueue(int numberOfElements, const T& (*makeValue)(unsigned int, T&))
+{
+	Queue<T> queue;
+	unsigned int random = 12345;
+	T value;
+	for (int i = 0; i < numberOfElements + numberOfElements / 4; i++) {
+		random = random * 1103515245 + 12345;
+		queue.pushBack(makeValue(random, value));
+		if (i < numberOfElements / 4) {
+			queue.popFront();
+		}
+	}
+	return queue;
+}
+
+const int& makeInt(unsigned int random, int& value)
+{
+	value = static_cast<int>(random);
+	return value;
+}
+
+const HealthPoints& makeHealthPoints(unsigned int random, HealthPoints& value)
+{
+	value = HealthPoints(1 << 20);
+	value -= static_cast<int>(random >> 12);
+	return value;
+}
+
+template <class T>
+void checkSorted(const Queue<T>& queue)
+{
+	for (int i = 1; i < queue.size(); i++) {
+		if (queue[i] < queue[i - 1]) {
+			std::cout << "  not sorted at " << i << std::endl;
+			return;
+		}
+	}
+}
+
+template <class T>
+void benchmarkSorts(const char* typeName, const Queue<T>& original)
+{
+	std::string name(typeName);
+	Queue<T> copied;
+	runBenchmark([&]() {
+		std::vector<T> elements;
+		elements.reserve(original.size());
+		for (const T& element : original) {
+			elements.push_back(element);
+		}
+		std::sort(elements.begin(), elements.end());
+		for (const T& element : elements) {
+			copied.pushBack(element);
+		}
+	}, name + ", std::vector copy, std::sort, pushBack", original.size());
+	checkSorted(copied);
+
+	Queue<T> compared = original;
+	runBenchmark([&]() {
+		sort(compared, [](const T& data1, const T& data2) { return data1 < data2; });
+	}, name + ", sort in place by comparison", original.size());
+	checkSorted(compared);
+
+	Queue<T> stable = original;
+	runBenchmark([&]() {
+		stableSort(stable, [](const T& data1, const T& data2) { return data1 < data2; });
+	}, name + ", stableSort in place by comparison", original.size());
+	checkSorted(stable);
+
+	Queue<T> radix = original;
+	runBenchmark([&]() {
+		sort(radix);
+	}, name + ", sort in place by radix", original.size());
+	checkSorted(radix);
+}
+
+void benchmarkMerge(int numberOfElements, int numberOfQueues)
+{
+	Queue<Queue<int>> sortedQueues;
+	for (int source = 0; source < numberOfQueues; source++) {
+		Queue<int> sortedQueue = wrappedQueue(numberOfElements / numberOfQueues, makeInt);
+		sort(sortedQueue);
+		sortedQueues.pushBack(sortedQueue);
+	}
+	Queue<Queue<int>> spliced = sortedQueues;
+
+	Queue<int> merged;
+	runBenchmark([&]() {
+		merged = merge(sortedQueues);
+	}, "int, merge of sorted queues", merged.size() + numberOfElements);
+	checkSorted(merged);
+
+	Queue<int> all;
+	runBenchmark([&]() {
+		for (int source = 0; source < spliced.size(); source++) {
+			all.splice(spliced[source]);
+		}
+		sort(all, [](int data1, int data2) { return data1 < data2; });
+	}, "int, splice and sort by comparison", numberOfElements);
+	checkSorted(all);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfElements = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+	int numberOfQueues = argc > 2 ? std::atoi(argv[2]) : 16;
+
+	benchmarkSorts("int", wrappedQueue(numberOfElements, makeInt));
+	benchmarkSorts("HealthPoints", wrappedQueue(numberOfElements, makeHealthPoints));
+	benchmarkMerge(numberOfElements, numberOfQueues);
+	return 0;
+}
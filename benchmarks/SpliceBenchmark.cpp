@@ -0,0 +1,75 @@
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+
+/*
+ * Rebalancing between two worker queues: every round the busy worker hands the back half of its elements
+ * to an idle one, which later stops and gives them all back. Done first element by element with popFront
+ * and pushBack, then with splitAt and splice.
+ *
+ * Usage: SpliceBenchmark [numberOfElements] [numberOfRounds]
+*/
+
+namespace {
+
+void handOverByElements(Queue<long long>& busy, Queue<long long>& idle)
+{
+	int kept = busy.size() - busy.size() / 2;
+	for (int i = 0; i < kept; i++) {
+		busy.pushBack(busy.popAndGet());
+	}
+	while (busy.size() > kept) {
+		idle.pushBack(busy.popAndGet());
+	}
+}
+
+void giveBackByElements(Queue<long long>& busy, Queue<long long>& idle)
+{
+	while (idle.size() > 0) {
+		busy.pushBack(idle.popAndGet());
+	}
+}
+
+void handOverBySplice(Queue<long long>& busy, Queue<long long>& idle)
+{
+	Queue<long long> backHalf = busy.splitAt(busy.size() - busy.size() / 2);
+	idle.splice(backHalf);
+}
+
+void giveBackBySplice(Queue<long long>& busy, Queue<long long>& idle)
+{
+	busy.splice(idle);
+}
+
+template <class HandOver, class GiveBack>
+void benchmarkRebalance(const char* name, int numberOfElements, int numberOfRounds, const HandOver& handOver,
+	const GiveBack& giveBack)
+{
+	Queue<long long> busy;
+	Queue<long long> idle;
+	for (int i = 0; i < numberOfElements; i++) {
+		busy.pushBack(i);
+	}
+	runBenchmark([&]() {
+		for (int round = 0; round < numberOfRounds; round++) {
+			handOver(busy, idle);
+			giveBack(busy, idle);
+		}
+	}, name, numberOfRounds);
+	std::cout << "  " << busy.size() << " elements, first " << busy.front() << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfElements = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+	int numberOfRounds = argc > 2 ? std::atoi(argv[2]) : 50;
+
+	benchmarkRebalance("rebalance, popFront and pushBack", numberOfElements, numberOfRounds,
+		handOverByElements, giveBackByElements);
+	benchmarkRebalance("rebalance, splitAt and splice", numberOfElements, numberOfRounds,
+		handOverBySplice, giveBackBySplice);
+	return 0;
+}
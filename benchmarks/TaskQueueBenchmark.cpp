@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+#include "../TaskQueue.h"
+
+/*
+ * Pushes batches of callbacks and runs them, with Queue<std::function<void()>> and with TaskQueue, for a
+ * capture that fits in std::function's small buffer and one that does not. Heap allocations are counted by
+ * replacing operator new, which std::function uses, and by the QueueBufferCache misses of TaskQueue.
+ *
+ * Usage: TaskQueueBenchmark [tasksPerBatch] [numberOfBatches]
+*/
+
+namespace {
+
+long long g_allocations = 0;
+
+struct SmallCapture {
+	long long* m_total;
+	void operator()() const { (*m_total)++; }
+};
+
+struct LargeCapture {
+	long long* m_total;
+	long long m_values[5];
+	void operator()() const { *m_total += m_values[0] + m_values[4]; }
+};
+
+template <class Capture>
+void benchmarkFunctionQueue(const char* name, int tasksPerBatch, int numberOfBatches, const Capture& capture)
+{
+	Queue<std::function<void()>> queue;
+	long long allocationsBefore = g_allocations;
+	runBenchmark([&]() {
+		for (int batch = 0; batch < numberOfBatches; batch++) {
+			for (int i = 0; i < tasksPerBatch; i++) {
+				queue.pushBack(capture);
+			}
+			while (queue.size() > 0) {
+				queue.popAndGet()();
+			}
+		}
+	}, name, static_cast<long long>(tasksPerBatch) * numberOfBatches);
+	std::cout << "  " << static_cast<double>(g_allocations - allocationsBefore) / tasksPerBatch / numberOfBatches
+		<< " operator new calls per task" << std::endl;
+}
+
+template <class Capture>
+void benchmarkTaskQueue(const char* name, int tasksPerBatch, int numberOfBatches, const Capture& capture)
+{
+	TaskQueue queue;
+	QueueBufferCache::resetStatistics();
+	long long allocationsBefore = g_allocations;
+	runBenchmark([&]() {
+		for (int batch = 0; batch < numberOfBatches; batch++) {
+			for (int i = 0; i < tasksPerBatch; i++) {
+				queue.pushBack(capture);
+			}
+			queue.runAll();
+		}
+	}, name, static_cast<long long>(tasksPerBatch) * numberOfBatches);
+	std::cout << "  " << g_allocations - allocationsBefore << " operator new calls, "
+		<< QueueBufferCache::statistics().m_misses << " QueueBufferCache misses in total" << std::endl;
+}
+
+}
+
+void* operator new(std::size_t bytes)
+{
+	g_allocations++;
+	void* block = std::malloc(bytes > 0 ? bytes : 1);
+	if (block == nullptr) {
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void operator delete(void* block) noexcept
+{
+	std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+	std::free(block);
+}
+
+int main(int argc, char *argv[])
+{
+	int tasksPerBatch = argc > 1 ? std::atoi(argv[1]) : 1000;
+	int numberOfBatches = argc > 2 ? std::atoi(argv[2]) : 5000;
+	long long total = 0;
+	SmallCapture small{ &total };
+	LargeCapture large{ &total, { 1, 2, 3, 4, 5 } };
+
+	benchmarkFunctionQueue("Queue<std::function>, 8 byte capture", tasksPerBatch, numberOfBatches, small);
+	benchmarkTaskQueue("TaskQueue, 8 byte capture", tasksPerBatch, numberOfBatches, small);
+	benchmarkFunctionQueue("Queue<std::function>, 48 byte capture", tasksPerBatch, numberOfBatches, large);
+	benchmarkTaskQueue("TaskQueue, 48 byte capture", tasksPerBatch, numberOfBatches, large);
+	std::cout << "total " << total << std::endl;
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include <cstdlib>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "BenchmarkUtils.h"
+#include "../TimerWheel.h"
+
+/*
+ * Ticks a TimerWheel holding numberOfTimers pending timers, and compares it with the filter() based
+ * delay queue it replaces, which copies every pending timer on every tick.
+ * Memory per timer is measured with glibc's mallinfo2, and is not reported on other C libraries.
+ *
+ * Usage: TimerWheelBenchmark [numberOfTimers] [numberOfTicks]
+*/
+
+namespace {
+
+struct PendingTask {
+	long long m_deadline;
+	long long m_task;
+};
+
+long long g_tick = 0;
+
+bool isPending(const PendingTask& task)
+{
+	return task.m_deadline > g_tick;
+}
+
+long long allocatedBytes()
+{
+#ifdef __GLIBC__
+	struct mallinfo2 info = mallinfo2();
+	return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+	return 0;
+#endif
+}
+
+long long randomDelay(unsigned& state, long long maxDelay)
+{
+	state = state * 1103515245u + 12345u;
+	return 1 + static_cast<long long>((state >> 4) % static_cast<unsigned>(maxDelay));
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfTimers = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int numberOfTicks = argc > 2 ? std::atoi(argv[2]) : 100000;
+	/* Deadlines are spread over numberOfTimers ticks, so about one timer expires per tick */
+	long long maxDelay = numberOfTimers;
+	unsigned state = 1;
+
+	std::cout << "--- timer wheel, " << numberOfTimers << " pending timers ---" << std::endl;
+	long long bytesBefore = allocatedBytes();
+	TimerWheel<long long>* wheel = new TimerWheel<long long>();
+	TimerWheel<long long>::TimerId* ids = new TimerWheel<long long>::TimerId[numberOfTimers];
+	long long idBytes = static_cast<long long>(sizeof(TimerWheel<long long>::TimerId)) * numberOfTimers;
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfTimers; i++) {
+			ids[i] = wheel->schedule(randomDelay(state, maxDelay), i);
+		}
+	}, "schedule", numberOfTimers);
+	long long bytesPerTimer = (allocatedBytes() - bytesBefore - idBytes) / numberOfTimers;
+	if (bytesPerTimer > 0) {
+		std::cout << "memory: " << bytesPerTimer << " bytes per timer" << std::endl;
+	}
+
+	Queue<long long> expired;
+	int numberOfExpired = 0;
+	runBenchmark([&]() {
+		for (int tick = 1; tick <= numberOfTicks; tick++) {
+			numberOfExpired += wheel->popExpired(tick, expired);
+			while (expired.size() > 0) {
+				expired.popFront();
+			}
+		}
+	}, "tick", numberOfTicks);
+	std::cout << numberOfExpired << " timers expired" << std::endl;
+
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfTimers; i++) {
+			wheel->cancel(ids[i]);
+		}
+	}, "cancel", numberOfTimers);
+	delete[] ids;
+	delete wheel;
+
+	std::cout << "--- filter per tick, " << numberOfTimers << " pending timers ---" << std::endl;
+	const int FILTER_TICKS = 20;
+	state = 1;
+	Queue<PendingTask> pending;
+	for (int i = 0; i < numberOfTimers; i++) {
+		pending.pushBack(PendingTask{ randomDelay(state, maxDelay), i });
+	}
+	runBenchmark([&]() {
+		for (g_tick = 1; g_tick <= FILTER_TICKS; g_tick++) {
+			pending = filter(pending, isPending);
+		}
+	}, "tick", FILTER_TICKS);
+	return 0;
+}
@@ -0,0 +1,74 @@
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "../Queue.h"
+
+/*
+ * Compares the memcpy path Queue takes for trivially copyable types with the
+ * element by element path, on the same 16 byte payload.
+ *
+ * Usage: TrivialDataBenchmark [numberOfElements]
+*/
+
+namespace {
+
+struct TrivialRecord {
+	long long m_key;
+	long long m_value;
+};
+
+/* Same layout, but the user provided copy operations force the generic path */
+struct GenericRecord {
+	long long m_key;
+	long long m_value;
+
+	GenericRecord() : m_key(0), m_value(0) {}
+	GenericRecord(const GenericRecord& other) : m_key(other.m_key), m_value(other.m_value) {}
+	GenericRecord& operator=(const GenericRecord& other)
+	{
+		m_key = other.m_key;
+		m_value = other.m_value;
+		return *this;
+	}
+};
+
+template <class Record>
+void benchmarkRecord(const char* name, int numberOfElements)
+{
+	std::cout << "--- " << name << (Queue<Record>::TRIVIAL_DATA ? " (trivial path)" : " (generic path)")
+		<< " ---" << std::endl;
+	Queue<Record> queue;
+	Record record;
+	record.m_value = 0;
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfElements; i++) {
+			record.m_key = i;
+			queue.pushBack(record);
+		}
+	}, "pushBack with growth", numberOfElements);
+
+	long long sum = 0;
+	runBenchmark([&]() {
+		for (int i = 0; i < 10; i++) {
+			Queue<Record> copy = queue;
+			sum += copy.size();
+		}
+	}, "copy", 10LL * numberOfElements);
+
+	runBenchmark([&]() {
+		for (int i = 0; i < numberOfElements; i++) {
+			sum += queue.popAndGet().m_key;
+		}
+	}, "popAndGet with shrinking", numberOfElements);
+	std::cout << "checksum " << sum << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfElements = argc > 1 ? std::atoi(argv[1]) : 10000000;
+	benchmarkRecord<TrivialRecord>("TrivialRecord", numberOfElements);
+	benchmarkRecord<GenericRecord>("GenericRecord", numberOfElements);
+	return 0;
+}
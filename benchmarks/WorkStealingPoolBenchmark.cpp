@@ -0,0 +1,142 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "BenchmarkUtils.h"
+#include "../WorkStealingPool.h"
+
+/*
+ * Fine-grained task benchmark: a root task fans out many tiny tasks, comparing the
+ * work-stealing pool with a pool of workers sharing a mutex-wrapped Queue<std::function<void()>>.
+ *
+ * Usage: WorkStealingPoolBenchmark [numberOfTasks] [numberOfWorkers]
+*/
+
+namespace {
+
+/*
+ * MutexQueuePool - the baseline: every submit and every pop takes the same lock.
+*/
+class MutexQueuePool {
+public:
+	explicit MutexQueuePool(int numberOfWorkers) : m_numberOfWorkers(numberOfWorkers), m_unfinished(0), m_stop(false)
+	{
+		m_threads = new std::thread[numberOfWorkers];
+		for (int i = 0; i < numberOfWorkers; i++) {
+			m_threads[i] = std::thread(&MutexQueuePool::workerLoop, this);
+		}
+	}
+
+	~MutexQueuePool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_available.notify_all();
+		for (int i = 0; i < m_numberOfWorkers; i++) {
+			m_threads[i].join();
+		}
+		delete[] m_threads;
+	}
+
+	template <class Function>
+	void submit(const Function& function)
+	{
+		m_unfinished++;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.pushBack(std::function<void()>(function));
+		}
+		m_available.notify_one();
+	}
+
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this]() { return m_unfinished.load() == 0; });
+	}
+
+private:
+	void workerLoop()
+	{
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_available.wait(lock, [this]() { return m_stop || m_tasks.size() > 0; });
+				if (!m_tasks.popFrontInto(task)) {
+					return;
+				}
+			}
+			task();
+			if (--m_unfinished == 0) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_done.notify_all();
+			}
+		}
+	}
+
+	int m_numberOfWorkers;
+	std::thread* m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_available;
+	std::condition_variable m_done;
+	Queue<std::function<void()>> m_tasks;
+	std::atomic<int> m_unfinished;
+	bool m_stop;
+};
+
+std::atomic<long long> g_sink(0);
+
+void tinyWork(int seed)
+{
+	long long value = seed;
+	for (int i = 0; i < 16; i++) {
+		value = value * 6364136223846793005LL + 1442695040888963407LL;
+	}
+	g_sink.fetch_add(value & 1, std::memory_order_relaxed);
+}
+
+template <class Pool>
+void fanOut(Pool& pool, int numberOfTasks)
+{
+	pool.submit([&pool, numberOfTasks]() {
+		for (int i = 0; i < numberOfTasks; i++) {
+			pool.submit([i]() { tinyWork(i); });
+		}
+	});
+	pool.wait();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	int numberOfTasks = argc > 1 ? std::atoi(argv[1]) : 200000;
+	int numberOfWorkers = argc > 2 ? std::atoi(argv[2]) : WorkStealingPool::defaultNumberOfWorkers();
+	std::cout << numberOfTasks << " tasks, " << numberOfWorkers << " workers" << std::endl;
+
+	{
+		MutexQueuePool pool(numberOfWorkers);
+		runBenchmark([&pool, numberOfTasks]() { fanOut(pool, numberOfTasks); },
+			"mutex Queue pool, fan-out", numberOfTasks);
+	}
+	{
+		WorkStealingPool pool(numberOfWorkers);
+		runBenchmark([&pool, numberOfTasks]() { fanOut(pool, numberOfTasks); },
+			"work-stealing pool, fan-out", numberOfTasks);
+	}
+	{
+		WorkStealingPool pool(numberOfWorkers);
+		Queue<int> queue;
+		for (int i = 0; i < numberOfTasks; i++) {
+			queue.pushBack(i);
+		}
+		runBenchmark([&pool, &queue]() { parallelTransform(pool, queue, [](int& n) { tinyWork(n); }, 64); },
+			"work-stealing pool, parallelTransform", numberOfTasks);
+	}
+	return 0;
+}